@@ -0,0 +1,244 @@
+// Portal culling: the building is split into cells (rooms and corridors, as unions of
+// boxes), linked by portals (the openings of the doors). Starting from the cell of the
+// camera, the cells seen through a portal are visited with the view frustum narrowed
+// to that portal, so only the instances that can be seen through the chain of openings
+// are drawn. Instances that are not in any cell are always drawn, and so is everything
+// when the camera is not inside a cell (e.g. above the walls).
+// The cells and the portals are the "cells" and "portals" sections of scene.json
+
+#define PORTAL_MAX_DEPTH 16			// max number of portals in a chain
+#define PORTAL_EYE_EPSILON 0.05f	// closer than this the frustum is not narrowed
+
+struct PortalCell {
+	std::string id;
+	std::vector<glm::vec3> boxMin, boxMax;
+	std::vector<Instance *> instances;
+	std::vector<int> portals;
+};
+
+struct Portal {
+	int cell[2];
+	std::vector<glm::vec3> polygon;		// convex, world space
+};
+
+struct CellPortals {
+	Scene *SC;
+	std::vector<PortalCell> cells;
+	std::vector<Portal> portals;
+	std::unordered_map<std::string, int> cellIds;
+
+	bool enabled = true;
+	int cameraCell = -1;
+	// of the last update(), for the debug overlay
+	int visitedCells = 0;
+	int visitedPortals = 0;
+	int culledInstances = 0;
+
+	void init(Scene *sc);
+	int addCell(std::string id);
+	void addBox(int c, glm::vec3 bmin, glm::vec3 bmax);
+	bool addInstance(int c, std::string instanceId);
+	int addPortal(int c0, int c1, std::vector<glm::vec3> polygon);
+	int findCell(glm::vec3 p);
+	bool update(glm::vec3 eye, const glm::mat4 &ViewPrj);
+
+	private:
+	glm::vec3 eye;
+	std::vector<bool> onPath;
+	void visit(int c, const std::vector<glm::vec4> &planes, int depth);
+	bool sphereInside(glm::vec4 s, const std::vector<glm::vec4> &planes);
+	static std::vector<glm::vec3> clip(const std::vector<glm::vec3> &P, glm::vec4 plane);
+};
+
+#ifdef CELLPORTALS_IMPLEMENTATION
+
+void CellPortals::init(Scene *sc) {
+	SC = sc;
+}
+
+int CellPortals::addCell(std::string id) {
+	cells.push_back({id, {}, {}, {}, {}});
+	cellIds[id] = cells.size() - 1;
+	return cells.size() - 1;
+}
+
+void CellPortals::addBox(int c, glm::vec3 bmin, glm::vec3 bmax) {
+	cells[c].boxMin.push_back(glm::min(bmin, bmax));
+	cells[c].boxMax.push_back(glm::max(bmin, bmax));
+}
+
+bool CellPortals::addInstance(int c, std::string instanceId) {
+	int h = SC->findInstance(instanceId);
+	if(h < 0) {
+		std::cout << "Cell " << cells[c].id << ": unknown instance " << instanceId << "\n";
+		return false;
+	}
+	cells[c].instances.push_back(SC->I[h]);
+	return true;
+}
+
+int CellPortals::addPortal(int c0, int c1, std::vector<glm::vec3> polygon) {
+	if(polygon.size() < 3) {
+		std::cout << "Portal between " << cells[c0].id << " and " << cells[c1].id << " has less than 3 vertices\n";
+		return -1;
+	}
+	portals.push_back({{c0, c1}, polygon});
+	cells[c0].portals.push_back(portals.size() - 1);
+	cells[c1].portals.push_back(portals.size() - 1);
+	return portals.size() - 1;
+}
+
+int CellPortals::findCell(glm::vec3 p) {
+	for(int c = 0; c < cells.size(); c++) {
+		for(int b = 0; b < cells[c].boxMin.size(); b++) {
+			if(glm::all(glm::greaterThanEqual(p, cells[c].boxMin[b])) &&
+			   glm::all(glm::lessThanEqual(p, cells[c].boxMax[b]))) {
+				return c;
+			}
+		}
+	}
+	return -1;
+}
+
+// Sets Instance::culled for the instances of all the cells, seen from eye with the
+// view-projection matrix ViewPrj. Returns true if any instance changed: the command
+// buffers must be recorded again
+bool CellPortals::update(glm::vec3 _eye, const glm::mat4 &ViewPrj) {
+	eye = _eye;
+	std::vector<bool> was;
+	for(auto &cell : cells) {
+		for(Instance *I : cell.instances) {
+			was.push_back(I->culled);
+			I->culled = true;
+		}
+	}
+
+	visitedCells = visitedPortals = 0;
+	cameraCell = enabled ? findCell(eye) : -1;
+	if(cameraCell >= 0) {
+		// side planes of the frustum, (normal, d) with the inside positive
+		std::vector<glm::vec4> planes;
+		auto row = [&](int r) {return glm::vec4(ViewPrj[0][r], ViewPrj[1][r], ViewPrj[2][r], ViewPrj[3][r]);};
+		glm::vec4 r0 = row(0), r1 = row(1), r3 = row(3);
+		for(glm::vec4 p : {r3 + r0, r3 - r0, r3 + r1, r3 - r1}) {
+			planes.push_back(p / glm::length(glm::vec3(p)));
+		}
+		onPath.assign(cells.size(), false);
+		visit(cameraCell, planes, 0);
+	} else {
+		for(auto &cell : cells) {
+			for(Instance *I : cell.instances) {
+				I->culled = false;
+			}
+		}
+	}
+
+	bool changed = false;
+	int n = 0;
+	culledInstances = 0;
+	for(auto &cell : cells) {
+		for(Instance *I : cell.instances) {
+			changed = changed || (was[n++] != I->culled);
+			culledInstances += I->culled ? 1 : 0;
+		}
+	}
+	return changed;
+}
+
+void CellPortals::visit(int c, const std::vector<glm::vec4> &planes, int depth) {
+	visitedCells++;
+	for(Instance *I : cells[c].instances) {
+		if(I->culled) {
+			const glm::mat4 &Wm = I->Wm;
+			glm::vec4 b = SC->M[I->Mid]->getBounds();
+			float scale = std::max(glm::length(glm::vec3(Wm[0])),
+						  std::max(glm::length(glm::vec3(Wm[1])), glm::length(glm::vec3(Wm[2]))));
+			glm::vec4 s = glm::vec4(glm::vec3(Wm * glm::vec4(glm::vec3(b), 1.0f)), b.w * scale);
+			I->culled = !sphereInside(s, planes);
+		}
+	}
+	if(depth >= PORTAL_MAX_DEPTH) {
+		return;
+	}
+
+	onPath[c] = true;
+	for(int pi : cells[c].portals) {
+		Portal &P = portals[pi];
+		int next = (P.cell[0] == c) ? P.cell[1] : P.cell[0];
+		if(onPath[next]) {
+			continue;
+		}
+		std::vector<glm::vec3> poly = P.polygon;
+		for(int i = 0; i < planes.size() && poly.size() >= 3; i++) {
+			poly = clip(poly, planes[i]);
+		}
+		if(poly.size() < 3) {
+			continue;
+		}
+		visitedPortals++;
+
+		// plane of the portal, the other cell on the positive side
+		glm::vec3 n = glm::normalize(glm::cross(P.polygon[1] - P.polygon[0], P.polygon[2] - P.polygon[0]));
+		float d = -glm::dot(n, P.polygon[0]);
+		float dist = glm::dot(n, eye) + d;
+		if(fabs(dist) < PORTAL_EYE_EPSILON) {
+			// standing in the doorway
+			visit(next, planes, depth + 1);
+			continue;
+		}
+		if(dist > 0.0f) {
+			n = -n;
+			d = -d;
+		}
+
+		// frustum narrowed to the visible part of the portal
+		glm::vec3 center(0.0f);
+		for(auto &v : poly) {
+			center += v / (float)poly.size();
+		}
+		std::vector<glm::vec4> narrow = {glm::vec4(n, d)};
+		for(int i = 0; i < poly.size(); i++) {
+			glm::vec3 e = glm::cross(poly[i] - eye, poly[(i + 1) % poly.size()] - eye);
+			float l = glm::length(e);
+			if(l < 1e-6f) {
+				continue;
+			}
+			glm::vec4 p = glm::vec4(e / l, -glm::dot(e / l, eye));
+			if(glm::dot(glm::vec3(p), center) + p.w < 0.0f) {
+				p = -p;
+			}
+			narrow.push_back(p);
+		}
+		visit(next, narrow, depth + 1);
+	}
+	onPath[c] = false;
+}
+
+bool CellPortals::sphereInside(glm::vec4 s, const std::vector<glm::vec4> &planes) {
+	for(auto &p : planes) {
+		if(glm::dot(glm::vec3(p), glm::vec3(s)) + p.w < -s.w) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Sutherland-Hodgman: the part of the convex polygon P on the positive side of plane
+std::vector<glm::vec3> CellPortals::clip(const std::vector<glm::vec3> &P, glm::vec4 plane) {
+	std::vector<glm::vec3> R;
+	for(int i = 0; i < P.size(); i++) {
+		const glm::vec3 &a = P[i];
+		const glm::vec3 &b = P[(i + 1) % P.size()];
+		float da = glm::dot(glm::vec3(plane), a) + plane.w;
+		float db = glm::dot(glm::vec3(plane), b) + plane.w;
+		if(da >= 0.0f) {
+			R.push_back(a);
+		}
+		if((da >= 0.0f) != (db >= 0.0f)) {
+			R.push_back(a + (b - a) * (da / (da - db)));
+		}
+	}
+	return R;
+}
+
+#endif
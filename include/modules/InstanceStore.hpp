@@ -0,0 +1,254 @@
+// Structure of arrays copy of the hot data of the scene instances (Scene::store): world
+// matrices, world bounding spheres, flags and model ids, in contiguous arrays indexed by
+// the handle of the instance (Instance::Iid). The batch kernels compute the
+// model-view-projection and normal matrices of all the instances, 8 at a time with AVX2
+// (cmake -DCG_HOSPITAL_AVX2=ON), one at a time otherwise.
+// Kept apart from Scene.hpp so that tools/InstanceBench.cpp can use it without Vulkan.
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <glm/glm.hpp>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define INSTANCE_LANES 8
+#else
+#define INSTANCE_LANES 1
+#endif
+
+enum InstanceFlags {
+	INSTANCE_STATIC = 1,
+	INSTANCE_OCCLUDER = 2,
+	INSTANCE_OCCLUDEE = 4
+};
+
+struct InstanceStore {
+	int count = 0;
+
+	// world matrices, one array per element: W[4 * c + r][h] is row r of column c of
+	// instance h. The arrays are padded with identities to a multiple of INSTANCE_LANES
+	std::vector<float> W[16];
+	std::vector<glm::vec4> localBounds;		// bounding sphere of the model
+	std::vector<glm::vec4> bounds;			// in world space, follows W
+	std::vector<uint32_t> flags;			// InstanceFlags
+	std::vector<int> modelId;
+
+	int add(const glm::mat4 &Wm, glm::vec4 modelBounds, int mid, uint32_t f);
+	void clear();
+	void setWorld(int h, const glm::mat4 &Wm);
+	glm::mat4 getWorld(int h);
+
+	// out must have count elements. simd = false runs the scalar kernels (for comparisons)
+	void computeMVP(const glm::mat4 &VP, glm::mat4 *out, bool simd = true);
+	void computeNormals(glm::mat4 *out, bool simd = true);
+	static glm::mat4 normalMatrix(const glm::mat4 &Wm);
+
+	private:
+	void mvpScalar(const glm::mat4 &VP, glm::mat4 *out, int from, int to);
+	void normalsScalar(glm::mat4 *out, int from, int to);
+#if INSTANCE_LANES == 8
+	static void transpose8(__m256 r[8]);
+	static void store8(const __m256 o[16], glm::mat4 *out, int n);
+#endif
+};
+
+#ifdef SCENE_IMPLEMENTATION
+
+// Returns the handle of the new instance
+int InstanceStore::add(const glm::mat4 &Wm, glm::vec4 modelBounds, int mid, uint32_t f) {
+	int h = count++;
+	int padded = (count + INSTANCE_LANES - 1) / INSTANCE_LANES * INSTANCE_LANES;
+	for(int e = 0; e < 16; e++) {
+		W[e].resize(padded, (e % 5 == 0) ? 1.0f : 0.0f);
+	}
+	localBounds.push_back(modelBounds);
+	bounds.push_back(glm::vec4(0.0f));
+	flags.push_back(f);
+	modelId.push_back(mid);
+	setWorld(h, Wm);
+	return h;
+}
+
+void InstanceStore::clear() {
+	count = 0;
+	for(int e = 0; e < 16; e++) {
+		W[e].clear();
+	}
+	localBounds.clear();
+	bounds.clear();
+	flags.clear();
+	modelId.clear();
+}
+
+void InstanceStore::setWorld(int h, const glm::mat4 &Wm) {
+	for(int e = 0; e < 16; e++) {
+		W[e][h] = Wm[e / 4][e % 4];
+	}
+	glm::vec4 s = localBounds[h];
+	float scale = std::max(glm::length(glm::vec3(Wm[0])),
+				  std::max(glm::length(glm::vec3(Wm[1])), glm::length(glm::vec3(Wm[2]))));
+	bounds[h] = glm::vec4(glm::vec3(Wm * glm::vec4(glm::vec3(s), 1.0f)), s.w * scale);
+}
+
+glm::mat4 InstanceStore::getWorld(int h) {
+	glm::mat4 Wm;
+	for(int e = 0; e < 16; e++) {
+		Wm[e / 4][e % 4] = W[e][h];
+	}
+	return Wm;
+}
+
+// Upper 3x3 of the inverse transpose (the cofactors over the determinant): enough for
+// directions, the shaders use it with w = 0
+glm::mat4 InstanceStore::normalMatrix(const glm::mat4 &Wm) {
+	glm::vec3 a0 = glm::vec3(Wm[0]), a1 = glm::vec3(Wm[1]), a2 = glm::vec3(Wm[2]);
+	glm::vec3 c0 = glm::cross(a1, a2), c1 = glm::cross(a2, a0), c2 = glm::cross(a0, a1);
+	float inv = 1.0f / glm::dot(a0, c0);
+	return glm::mat4(glm::vec4(c0 * inv, 0.0f), glm::vec4(c1 * inv, 0.0f), glm::vec4(c2 * inv, 0.0f),
+					 glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+}
+
+void InstanceStore::mvpScalar(const glm::mat4 &VP, glm::mat4 *out, int from, int to) {
+	for(int h = from; h < to; h++) {
+		for(int c = 0; c < 4; c++) {
+			for(int r = 0; r < 4; r++) {
+				out[h][c][r] = VP[0][r] * W[4 * c][h] + VP[1][r] * W[4 * c + 1][h] +
+							   VP[2][r] * W[4 * c + 2][h] + VP[3][r] * W[4 * c + 3][h];
+			}
+		}
+	}
+}
+
+void InstanceStore::normalsScalar(glm::mat4 *out, int from, int to) {
+	for(int h = from; h < to; h++) {
+		glm::vec3 a0(W[0][h], W[1][h], W[2][h]);
+		glm::vec3 a1(W[4][h], W[5][h], W[6][h]);
+		glm::vec3 a2(W[8][h], W[9][h], W[10][h]);
+		glm::vec3 c0 = glm::cross(a1, a2), c1 = glm::cross(a2, a0), c2 = glm::cross(a0, a1);
+		float inv = 1.0f / glm::dot(a0, c0);
+		out[h] = glm::mat4(glm::vec4(c0 * inv, 0.0f), glm::vec4(c1 * inv, 0.0f), glm::vec4(c2 * inv, 0.0f),
+						   glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+	}
+}
+
+#if INSTANCE_LANES == 8
+// rows become columns: r[i] lane j <-> r[j] lane i
+void InstanceStore::transpose8(__m256 r[8]) {
+	__m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+	__m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+	__m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+	__m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+	__m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+	__m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+	__m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+	__m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+	__m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+	__m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+	__m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+	__m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+	__m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+	__m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+	__m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+	__m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+	r[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+	r[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+	r[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+	r[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+	r[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+	r[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+	r[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+	r[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+}
+
+// o[e] lane i is element e of matrix i: the first n matrices are written to out
+void InstanceStore::store8(const __m256 o[16], glm::mat4 *out, int n) {
+	__m256 lo[8], hi[8];
+	for(int i = 0; i < 8; i++) {
+		lo[i] = o[i];
+		hi[i] = o[i + 8];
+	}
+	transpose8(lo);
+	transpose8(hi);
+	for(int i = 0; i < n; i++) {
+		_mm256_storeu_ps(&out[i][0][0], lo[i]);
+		_mm256_storeu_ps(&out[i][2][0], hi[i]);
+	}
+}
+#endif
+
+void InstanceStore::computeMVP(const glm::mat4 &VP, glm::mat4 *out, bool simd) {
+	int h = 0;
+#if INSTANCE_LANES == 8
+	if(simd) {
+		__m256 vp[16];
+		for(int e = 0; e < 16; e++) {
+			vp[e] = _mm256_set1_ps(VP[e / 4][e % 4]);
+		}
+		const float *w0[16];
+		for(int e = 0; e < 16; e++) {
+			w0[e] = W[e].data();
+		}
+		for(; h < count; h += 8) {
+			__m256 w[16], o[16];
+			for(int e = 0; e < 16; e++) {
+				w[e] = _mm256_loadu_ps(w0[e] + h);
+			}
+			for(int c = 0; c < 4; c++) {
+				for(int r = 0; r < 4; r++) {
+					__m256 s = _mm256_mul_ps(vp[r], w[4 * c]);
+					s = _mm256_add_ps(s, _mm256_mul_ps(vp[4 + r], w[4 * c + 1]));
+					s = _mm256_add_ps(s, _mm256_mul_ps(vp[8 + r], w[4 * c + 2]));
+					o[4 * c + r] = _mm256_add_ps(s, _mm256_mul_ps(vp[12 + r], w[4 * c + 3]));
+				}
+			}
+			store8(o, out + h, std::min(8, count - h));
+		}
+	}
+#endif
+	mvpScalar(VP, out, h, count);
+}
+
+void InstanceStore::computeNormals(glm::mat4 *out, bool simd) {
+	int h = 0;
+#if INSTANCE_LANES == 8
+	if(simd) {
+		__m256 zero = _mm256_setzero_ps();
+		__m256 one = _mm256_set1_ps(1.0f);
+		auto cross = [](__m256 ax, __m256 ay, __m256 az, __m256 bx, __m256 by, __m256 bz, __m256 *c) {
+			c[0] = _mm256_sub_ps(_mm256_mul_ps(ay, bz), _mm256_mul_ps(az, by));
+			c[1] = _mm256_sub_ps(_mm256_mul_ps(az, bx), _mm256_mul_ps(ax, bz));
+			c[2] = _mm256_sub_ps(_mm256_mul_ps(ax, by), _mm256_mul_ps(ay, bx));
+		};
+		const float *w0[9];
+		for(int c = 0; c < 3; c++) {
+			for(int r = 0; r < 3; r++) {
+				w0[3 * c + r] = W[4 * c + r].data();
+			}
+		}
+		for(; h < count; h += 8) {
+			__m256 a[9];
+			for(int e = 0; e < 9; e++) {
+				a[e] = _mm256_loadu_ps(w0[e] + h);
+			}
+			__m256 c0[3], c1[3], c2[3];
+			cross(a[3], a[4], a[5], a[6], a[7], a[8], c0);
+			cross(a[6], a[7], a[8], a[0], a[1], a[2], c1);
+			cross(a[0], a[1], a[2], a[3], a[4], a[5], c2);
+			__m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a[0], c0[0]), _mm256_mul_ps(a[1], c0[1])),
+									   _mm256_mul_ps(a[2], c0[2]));
+			__m256 inv = _mm256_div_ps(one, det);
+			__m256 o[16] = {
+				_mm256_mul_ps(c0[0], inv), _mm256_mul_ps(c0[1], inv), _mm256_mul_ps(c0[2], inv), zero,
+				_mm256_mul_ps(c1[0], inv), _mm256_mul_ps(c1[1], inv), _mm256_mul_ps(c1[2], inv), zero,
+				_mm256_mul_ps(c2[0], inv), _mm256_mul_ps(c2[1], inv), _mm256_mul_ps(c2[2], inv), zero,
+				zero, zero, zero, one
+			};
+			store8(o, out + h, std::min(8, count - h));
+		}
+	}
+#endif
+	normalsScalar(out, h, count);
+}
+
+#endif
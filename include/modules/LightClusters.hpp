@@ -0,0 +1,153 @@
+// Clustered forward shading: point lights are binned on the CPU into view space
+// froxels (CLUSTER_X x CLUSTER_Y screen tiles, CLUSTER_Z exponential depth slices),
+// so that each fragment only evaluates the lights of its own cluster.
+// The grid sizes must match the ones in shaders/Lambert-Blinn-Clustered.frag
+
+#define CLUSTER_X 16
+#define CLUSTER_Y 9
+#define CLUSTER_Z 24
+#define CLUSTER_COUNT (CLUSTER_X * CLUSTER_Y * CLUSTER_Z)
+
+#define MAX_CLUSTER_LIGHTS 1024
+#define MAX_CLUSTER_LIGHT_INDICES 65536
+
+// std430 layouts of the storage buffers
+struct ClusterLight {
+	glm::vec4 posRadius;	// world position, radius of influence
+	glm::vec4 color;
+};
+
+struct ClusterRange {
+	uint32_t offset;
+	uint32_t count;
+};
+
+struct LightClusters {
+	float fovy, aspect, nearZ, farZ;
+
+	std::vector<ClusterLight> lights;
+	std::vector<ClusterRange> grid;
+	std::vector<uint32_t> indices;
+	int indicesCount = 0;
+
+	// view space bounding box of every cluster, depends only on the projection
+	std::vector<glm::vec3> boxMin, boxMax;
+	std::vector<std::vector<uint32_t>> bins;
+
+	void init(float _fovy, float _aspect, float _nearZ, float _farZ);
+	void setProjection(float _fovy, float _aspect, float _nearZ, float _farZ);
+	int addLight(glm::vec3 pos, glm::vec3 color, float radius);
+	int slice(float depth);
+	glm::vec4 zParams();
+	void build(const glm::mat4 &View);
+};
+
+#ifdef LIGHTCLUSTERS_IMPLEMENTATION
+
+void LightClusters::init(float _fovy, float _aspect, float _nearZ, float _farZ) {
+	lights.reserve(MAX_CLUSTER_LIGHTS);
+	grid.resize(CLUSTER_COUNT);
+	indices.resize(MAX_CLUSTER_LIGHT_INDICES);
+	bins.resize(CLUSTER_COUNT);
+	setProjection(_fovy, _aspect, _nearZ, _farZ);
+}
+
+// To be called again when the aspect ratio changes
+void LightClusters::setProjection(float _fovy, float _aspect, float _nearZ, float _farZ) {
+	fovy = _fovy;
+	aspect = _aspect;
+	nearZ = _nearZ;
+	farZ = _farZ;
+
+	boxMin.resize(CLUSTER_COUNT);
+	boxMax.resize(CLUSTER_COUNT);
+	float ty = tan(fovy * 0.5f);
+	float tx = ty * aspect;
+	for(int z = 0; z < CLUSTER_Z; z++) {
+		float d0 = nearZ * pow(farZ / nearZ, (float)z / CLUSTER_Z);
+		float d1 = nearZ * pow(farZ / nearZ, (float)(z + 1) / CLUSTER_Z);
+		if(z == 0) {
+			d0 = 0.0f;	// the first slice also holds everything closer than nearZ
+		}
+		for(int y = 0; y < CLUSTER_Y; y++) {
+			// tile rows go top to bottom, the projection has the y axis flipped
+			float ny0 = 1.0f - 2.0f * (float)(y + 1) / CLUSTER_Y;
+			float ny1 = 1.0f - 2.0f * (float)y / CLUSTER_Y;
+			for(int x = 0; x < CLUSTER_X; x++) {
+				float nx0 = -1.0f + 2.0f * (float)x / CLUSTER_X;
+				float nx1 = -1.0f + 2.0f * (float)(x + 1) / CLUSTER_X;
+				int c = (z * CLUSTER_Y + y) * CLUSTER_X + x;
+				boxMin[c] = glm::vec3(std::min(nx0 * d0, nx0 * d1) * tx, std::min(ny0 * d0, ny0 * d1) * ty, -d1);
+				boxMax[c] = glm::vec3(std::max(nx1 * d0, nx1 * d1) * tx, std::max(ny1 * d0, ny1 * d1) * ty, -d0);
+			}
+		}
+	}
+}
+
+int LightClusters::addLight(glm::vec3 pos, glm::vec3 color, float radius) {
+	if(lights.size() >= MAX_CLUSTER_LIGHTS) {
+		std::cout << "Too many lights, max is " << MAX_CLUSTER_LIGHTS << "\n";
+		return -1;
+	}
+	lights.push_back({glm::vec4(pos, radius), glm::vec4(color, 1.0f)});
+	return lights.size() - 1;
+}
+
+int LightClusters::slice(float depth) {
+	if(depth <= nearZ) {
+		return 0;
+	}
+	int s = (int)(log(depth / nearZ) / log(farZ / nearZ) * CLUSTER_Z);
+	return std::min(s, CLUSTER_Z - 1);
+}
+
+// slice = log(depth) * x + y, as used by the fragment shader
+glm::vec4 LightClusters::zParams() {
+	float k = (float)CLUSTER_Z / log(farZ / nearZ);
+	return glm::vec4(k, -k * log(nearZ), nearZ, farZ);
+}
+
+// Bins all the lights with the camera View matrix: fills grid and indices
+void LightClusters::build(const glm::mat4 &View) {
+	for(auto &b : bins) {
+		b.clear();
+	}
+
+	for(int l = 0; l < lights.size(); l++) {
+		float r = lights[l].posRadius.w;
+		glm::vec3 c = glm::vec3(View * glm::vec4(glm::vec3(lights[l].posRadius), 1.0f));
+		float depth = -c.z;
+		if((depth + r <= 0.0f) || (depth - r >= farZ)) {
+			continue;
+		}
+		int z0 = slice(depth - r);
+		int z1 = slice(depth + r);
+		for(int z = z0; z <= z1; z++) {
+			for(int y = 0; y < CLUSTER_Y; y++) {
+				for(int x = 0; x < CLUSTER_X; x++) {
+					int ci = (z * CLUSTER_Y + y) * CLUSTER_X + x;
+					// sphere - box test: distance from the closest point of the box
+					glm::vec3 q = glm::clamp(c, boxMin[ci], boxMax[ci]) - c;
+					if(glm::dot(q, q) <= r * r) {
+						bins[ci].push_back(l);
+					}
+				}
+			}
+		}
+	}
+
+	indicesCount = 0;
+	bool overflow = false;
+	for(int ci = 0; ci < CLUSTER_COUNT; ci++) {
+		int n = std::min((int)bins[ci].size(), MAX_CLUSTER_LIGHT_INDICES - indicesCount);
+		overflow = overflow || (n < bins[ci].size());
+		grid[ci] = {(uint32_t)indicesCount, (uint32_t)n};
+		std::copy(bins[ci].begin(), bins[ci].begin() + n, indices.begin() + indicesCount);
+		indicesCount += n;
+	}
+	if(overflow) {
+		std::cout << "Light index list full: some lights were dropped\n";
+	}
+}
+
+#endif
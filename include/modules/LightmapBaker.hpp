@@ -0,0 +1,483 @@
+// Lightmap baker: the diffuse light of the static point lights on the instances of a
+// technique is computed once, by ray casting over a BVH of their triangles (shadows
+// included), and stored in a single RGBM atlas. Every triangle gets its own chart in
+// the second UV set of its model, every instance its own region of the atlas.
+// The result is cached on disk, and baked again only when the hash of the geometry,
+// of the lights or of the parameters changes.
+
+#define LIGHTMAP_VERSION 1
+#define LIGHTMAP_PADDING 2			// texels around each chart, bilinear filtering safe
+#define LIGHTMAP_MAX_REGION 1024	// max side of the region of a model
+#define LIGHTMAP_MAX_SIZE 4096		// max side of the atlas
+#define LIGHTMAP_MAX_TRIES 16		// density reductions before giving up (0.75^16 = 1%)
+#define LIGHTMAP_RGBM_RANGE 8.0f	// must match shaders/Lightmapped.frag
+
+struct LightmapChart {
+	int R;							// side of the region, in texels
+	std::vector<glm::vec2> q;		// texel coordinates of the (unwelded) vertices
+	std::vector<glm::ivec4> rect;	// x, y, w, h of the chart of every triangle
+};
+
+struct LightmapBVHNode {
+	glm::vec3 bmin, bmax;
+	int first;			// first child, or first triangle of a leaf
+	int count;			// triangles of a leaf, 0 for inner nodes
+};
+
+struct LightmapBaker {
+	// same light model as the fragment shaders
+	float g = 5.0f;
+	float decayFactor = 1.0f;
+	float texelsPerUnit = 1.0f;		// world space density of the lightmap
+	std::vector<glm::vec4> lightPosRadius;
+	std::vector<glm::vec3> lightColor;
+
+	// results: atlas size and scale-offset of the region of each instance
+	int width, height;
+	std::vector<glm::vec4> ST;
+
+	std::unordered_map<int, LightmapChart> charts;
+
+	// world space triangles (v0, e1, e2) and their BVH
+	std::vector<glm::vec3> tris;
+	std::vector<int> triIds;
+	std::vector<LightmapBVHNode> nodes;
+
+	void addLight(glm::vec3 pos, glm::vec3 color, float radius);
+	std::string bake(BaseProject *bp, Scene *SC, int tech, int uv2Offset, std::string cacheDir);
+
+	void unweld(Model *M, int stride);
+	bool makeChart(Model *M, VertexDescriptor *VD, float density, LightmapChart &C);
+	static int packShelves(std::vector<glm::ivec2> &sizes, int width, std::vector<glm::ivec2> &pos);
+	void buildBVH();
+	void buildNode(int id, int first, int count);
+	bool occluded(glm::vec3 o, glm::vec3 d, float tmax);
+};
+
+#ifdef LIGHTMAPBAKER_IMPLEMENTATION
+
+void LightmapBaker::addLight(glm::vec3 pos, glm::vec3 color, float radius) {
+	lightPosRadius.push_back(glm::vec4(pos, radius));
+	lightColor.push_back(color);
+}
+
+// one vertex per index, so that every triangle can have its own chart
+void LightmapBaker::unweld(Model *M, int stride) {
+	std::vector<unsigned char> V(M->indices.size() * stride);
+	for(int i = 0; i < M->indices.size(); i++) {
+		memcpy(&V[i * stride], &M->vertices[M->indices[i] * stride], stride);
+		M->indices[i] = i;
+	}
+	M->vertices = V;
+}
+
+// Shelf packing, tallest first: returns the height used
+int LightmapBaker::packShelves(std::vector<glm::ivec2> &sizes, int width, std::vector<glm::ivec2> &pos) {
+	std::vector<int> order(sizes.size());
+	for(int i = 0; i < sizes.size(); i++) order[i] = i;
+	std::sort(order.begin(), order.end(), [&](int a, int b) {return sizes[a].y > sizes[b].y;});
+
+	pos.resize(sizes.size());
+	int px = 0, py = 0, shelfH = 0;
+	for(int i : order) {
+		if((px + sizes[i].x > width) && (px > 0)) {
+			px = 0;
+			py += shelfH;
+			shelfH = 0;
+		}
+		pos[i] = glm::ivec2(px, py);
+		px += sizes[i].x;
+		shelfH = std::max(shelfH, sizes[i].y);
+	}
+	return py + shelfH;
+}
+
+// Each triangle is laid flat in its own plane (first edge along x), at density texels per
+// model unit, and the charts are packed in the smallest square region. False if too large.
+bool LightmapBaker::makeChart(Model *M, VertexDescriptor *VD, float density, LightmapChart &C) {
+	int stride = VD->Bindings[0].stride;
+	int nt = M->indices.size() / 3;
+	std::vector<glm::ivec2> sizes(nt), pos;
+	C.q.resize(nt * 3);
+	C.rect.resize(nt);
+
+	long area = 0;
+	int maxW = 1;
+	for(int t = 0; t < nt; t++) {
+		glm::vec3 p[3];
+		for(int k = 0; k < 3; k++) {
+			p[k] = *(glm::vec3 *)(&M->vertices[M->indices[3 * t + k] * stride + VD->Position.offset]);
+		}
+		glm::vec3 e0 = p[1] - p[0], e2 = p[2] - p[0];
+		glm::vec3 n = glm::cross(e0, e2);
+		glm::vec2 q[3] = {glm::vec2(0.0f), glm::vec2(0.0f), glm::vec2(0.0f)};
+		if((glm::length(e0) > 0.0f) && (glm::length(n) > 0.0f)) {
+			glm::vec3 u = glm::normalize(e0);
+			glm::vec3 v = glm::cross(glm::normalize(n), u);
+			q[1] = glm::vec2(glm::length(e0), 0.0f) * density;
+			q[2] = glm::vec2(glm::dot(e2, u), glm::dot(e2, v)) * density;
+		}
+		float minX = std::min(0.0f, q[2].x);
+		float maxX = std::max(q[1].x, q[2].x);
+		for(int k = 0; k < 3; k++) {
+			C.q[3 * t + k] = q[k] + glm::vec2(LIGHTMAP_PADDING - minX, LIGHTMAP_PADDING);
+		}
+		sizes[t] = glm::ivec2((int)ceil(maxX - minX), (int)ceil(q[2].y)) + 2 * LIGHTMAP_PADDING + 1;
+		area += sizes[t].x * sizes[t].y;
+		maxW = std::max(maxW, sizes[t].x);
+	}
+
+	C.R = std::max(maxW, (int)ceil(sqrt((double)area)));
+	while(packShelves(sizes, C.R, pos) > C.R) {
+		C.R = std::max(C.R + 1, (int)(C.R * 1.05f));
+	}
+	if(C.R > LIGHTMAP_MAX_REGION) {
+		return false;
+	}
+
+	for(int t = 0; t < nt; t++) {
+		C.rect[t] = glm::ivec4(pos[t], sizes[t]);
+		for(int k = 0; k < 3; k++) {
+			C.q[3 * t + k] += glm::vec2(pos[t]);
+		}
+	}
+	return true;
+}
+
+void LightmapBaker::buildBVH() {
+	int nt = tris.size() / 3;
+	triIds.resize(nt);
+	for(int i = 0; i < nt; i++) triIds[i] = i;
+	nodes.clear();
+	nodes.reserve(2 * nt + 1);
+	nodes.push_back({});
+	buildNode(0, 0, nt);
+}
+
+// median split along the longest axis of the centroids, four triangles per leaf
+void LightmapBaker::buildNode(int id, int first, int count) {
+	glm::vec3 bmin(1e30f), bmax(-1e30f), cmin(1e30f), cmax(-1e30f);
+	for(int i = first; i < first + count; i++) {
+		int t = triIds[i];
+		glm::vec3 p0 = tris[3 * t], p1 = p0 + tris[3 * t + 1], p2 = p0 + tris[3 * t + 2];
+		bmin = glm::min(bmin, glm::min(p0, glm::min(p1, p2)));
+		bmax = glm::max(bmax, glm::max(p0, glm::max(p1, p2)));
+		glm::vec3 c = (p0 + p1 + p2) / 3.0f;
+		cmin = glm::min(cmin, c);
+		cmax = glm::max(cmax, c);
+	}
+	nodes[id].bmin = bmin;
+	nodes[id].bmax = bmax;
+
+	if(count <= 4) {
+		nodes[id].first = first;
+		nodes[id].count = count;
+		return;
+	}
+
+	glm::vec3 ext = cmax - cmin;
+	int axis = (ext.x > ext.y) ? ((ext.x > ext.z) ? 0 : 2) : ((ext.y > ext.z) ? 1 : 2);
+	int mid = first + count / 2;
+	std::nth_element(triIds.begin() + first, triIds.begin() + mid, triIds.begin() + first + count,
+		[&](int a, int b) {
+			return (tris[3 * a][axis] * 3.0f + tris[3 * a + 1][axis] + tris[3 * a + 2][axis]) <
+				   (tris[3 * b][axis] * 3.0f + tris[3 * b + 1][axis] + tris[3 * b + 2][axis]);
+		});
+
+	// the two children are consecutive
+	int l = nodes.size();
+	nodes[id].first = l;
+	nodes[id].count = 0;
+	nodes.push_back({});
+	nodes.push_back({});
+	buildNode(l, first, mid - first);
+	buildNode(l + 1, mid, first + count - mid);
+}
+
+// any hit along o + t d, 0 < t < tmax
+bool LightmapBaker::occluded(glm::vec3 o, glm::vec3 d, float tmax) {
+	glm::vec3 inv = 1.0f / d;
+	int stack[64];
+	int sp = 0;
+	stack[sp++] = 0;
+	while(sp > 0) {
+		const LightmapBVHNode &N = nodes[stack[--sp]];
+		glm::vec3 t0 = (N.bmin - o) * inv, t1 = (N.bmax - o) * inv;
+		glm::vec3 tn = glm::min(t0, t1), tf = glm::max(t0, t1);
+		float tnear = std::max(std::max(tn.x, tn.y), std::max(tn.z, 0.0f));
+		float tfar  = std::min(std::min(tf.x, tf.y), std::min(tf.z, tmax));
+		if(tnear > tfar) {
+			continue;
+		}
+		if(N.count == 0) {
+			stack[sp++] = N.first;
+			stack[sp++] = N.first + 1;
+			continue;
+		}
+		for(int i = N.first; i < N.first + N.count; i++) {
+			// Moller - Trumbore
+			int t = triIds[i];
+			const glm::vec3 &v0 = tris[3 * t], &e1 = tris[3 * t + 1], &e2 = tris[3 * t + 2];
+			glm::vec3 p = glm::cross(d, e2);
+			float det = glm::dot(e1, p);
+			if(fabs(det) < 1e-12f) continue;
+			float id = 1.0f / det;
+			glm::vec3 s = o - v0;
+			float u = glm::dot(s, p) * id;
+			if((u < 0.0f) || (u > 1.0f)) continue;
+			glm::vec3 q = glm::cross(s, e1);
+			float v = glm::dot(d, q) * id;
+			if((v < 0.0f) || (u + v > 1.0f)) continue;
+			float th = glm::dot(e2, q) * id;
+			if((th > 0.0f) && (th < tmax)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+// barycentric coordinates of the point of triangle abc closest to p
+static glm::vec3 lightmapClosestBarycentric(glm::vec2 p, glm::vec2 a, glm::vec2 b, glm::vec2 c) {
+	glm::vec2 v0 = b - a, v1 = c - a, v2 = p - a;
+	float den = v0.x * v1.y - v1.x * v0.y;
+	if(fabs(den) > 1e-12f) {
+		float v = (v2.x * v1.y - v1.x * v2.y) / den;
+		float w = (v0.x * v2.y - v2.x * v0.y) / den;
+		if((v >= 0.0f) && (w >= 0.0f) && (v + w <= 1.0f)) {
+			return glm::vec3(1.0f - v - w, v, w);
+		}
+	}
+	// outside (padding texels): closest point on the edges
+	glm::vec2 P[3] = {a, b, c};
+	glm::vec3 best(1.0f, 0.0f, 0.0f);
+	float bestD = 1e30f;
+	for(int e = 0; e < 3; e++) {
+		glm::vec2 A = P[e], B = P[(e + 1) % 3];
+		float l = glm::dot(B - A, B - A);
+		float t = (l > 0.0f) ? std::clamp(glm::dot(p - A, B - A) / l, 0.0f, 1.0f) : 0.0f;
+		glm::vec2 q = A + t * (B - A);
+		float d = glm::dot(p - q, p - q);
+		if(d < bestD) {
+			bestD = d;
+			best = glm::vec3(0.0f);
+			best[e] = 1.0f - t;
+			best[(e + 1) % 3] = t;
+		}
+	}
+	return best;
+}
+
+// Charts the models of the instances of technique tech (writing the second UV set at
+// uv2Offset in their vertices), and returns the lightmap file, baking it if not cached
+std::string LightmapBaker::bake(BaseProject *bp, Scene *SC, int tech, int uv2Offset, std::string cacheDir) {
+	auto startTime = std::chrono::high_resolution_clock::now();
+	TechniqueInstances &TI = SC->TI[tech];
+	VertexDescriptor *VD = TI.T->VD;
+	int stride = VD->Bindings[0].stride;
+	if(!VD->Position.hasIt || !VD->Normal.hasIt) {
+		throw std::runtime_error("Lightmapped models need positions and normals");
+	}
+
+	// largest scale of each model, to reach texelsPerUnit on all its instances
+	std::unordered_map<int, float> maxScale;
+	for(int j = 0; j < TI.InstanceCount; j++) {
+		glm::mat4 &Wm = TI.I[j].Wm;
+		float s = std::max(glm::length(glm::vec3(Wm[0])), std::max(glm::length(glm::vec3(Wm[1])), glm::length(glm::vec3(Wm[2]))));
+		maxScale[TI.I[j].Mid] = std::max(maxScale[TI.I[j].Mid], s);
+	}
+	for(auto &m : maxScale) {
+		unweld(SC->M[m.first], stride);
+	}
+
+	// charts and atlas, with a lower density until everything fits
+	std::vector<glm::ivec2> sizes(TI.InstanceCount), pos;
+	for(int tries = 0; ; tries++) {
+		float density = texelsPerUnit * pow(0.75f, tries);
+		if(tries > LIGHTMAP_MAX_TRIES) {
+			// every chart keeps its padding at any density: too many triangles
+			throw std::runtime_error("Lightmap does not fit in " + std::to_string(LIGHTMAP_MAX_SIZE) +
+									 " texels even at " + std::to_string(density / 0.75f) + " texels per unit");
+		}
+		bool fits = true;
+		for(auto &m : maxScale) {
+			fits = fits && makeChart(SC->M[m.first], VD, density * m.second, charts[m.first]);
+		}
+		long area = 0;
+		int maxR = 1;
+		for(int j = 0; fits && (j < TI.InstanceCount); j++) {
+			int R = charts[TI.I[j].Mid].R;
+			sizes[j] = glm::ivec2(R, R);
+			area += R * R;
+			maxR = std::max(maxR, R);
+		}
+		if(fits) {
+			width = 1;
+			while((width < maxR) || (width * width < area)) width *= 2;
+			width = std::min(width, LIGHTMAP_MAX_SIZE);
+			int h = packShelves(sizes, width, pos);
+			height = 1;
+			while(height < h) height *= 2;
+			if(height <= LIGHTMAP_MAX_SIZE) {
+				break;
+			}
+		}
+		std::cout << "Lightmap too large, reducing the density to " << density * 0.75f << " texels per unit\n";
+	}
+
+	// second UV set, relative to the region of the model
+	for(auto &m : maxScale) {
+		Model *M = SC->M[m.first];
+		LightmapChart &C = charts[m.first];
+		for(int i = 0; i < M->indices.size(); i++) {
+			*(glm::vec2 *)(&M->vertices[i * stride + uv2Offset]) = C.q[i] / (float)C.R;
+		}
+		M->cleanup();
+		M->initMesh(bp, VD, false);
+	}
+	ST.resize(TI.InstanceCount);
+	for(int j = 0; j < TI.InstanceCount; j++) {
+		ST[j] = glm::vec4((float)sizes[j].x / width, (float)sizes[j].y / height,
+						  (float)pos[j].x / width,   (float)pos[j].y / height);
+	}
+
+	// FNV-1a of everything that affects the result
+	uint64_t hash = 14695981039346656037ULL;
+	auto H = [&](const void *data, size_t size) {
+		for(size_t i = 0; i < size; i++) {
+			hash = (hash ^ ((const unsigned char *)data)[i]) * 1099511628211ULL;
+		}
+	};
+	int version = LIGHTMAP_VERSION;
+	H(&version, sizeof(version));
+	H(&g, sizeof(g));
+	H(&decayFactor, sizeof(decayFactor));
+	H(&texelsPerUnit, sizeof(texelsPerUnit));
+	H(lightPosRadius.data(), lightPosRadius.size() * sizeof(glm::vec4));
+	H(lightColor.data(), lightColor.size() * sizeof(glm::vec3));
+	for(int j = 0; j < TI.InstanceCount; j++) {
+		Model *M = SC->M[TI.I[j].Mid];
+		H(&TI.I[j].Wm, sizeof(glm::mat4));
+		H(M->vertices.data(), M->vertices.size());
+	}
+	char hex[17];
+	snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)hash);
+	std::string file = cacheDir + "/Lightmap_" + hex + ".png";
+
+	if(std::filesystem::exists(file)) {
+		std::cout << "Lightmap " << width << "x" << height << " found in cache: " << file << "\n";
+		return file;
+	}
+
+	// occluders: all the triangles of the technique, in world space
+	tris.clear();
+	for(int j = 0; j < TI.InstanceCount; j++) {
+		Model *M = SC->M[TI.I[j].Mid];
+		glm::mat4 &Wm = TI.I[j].Wm;
+		for(int i = 0; i + 2 < M->indices.size(); i += 3) {
+			glm::vec3 p[3];
+			for(int k = 0; k < 3; k++) {
+				p[k] = glm::vec3(Wm * glm::vec4(*(glm::vec3 *)(&M->vertices[(i + k) * stride + VD->Position.offset]), 1.0f));
+			}
+			tris.push_back(p[0]);
+			tris.push_back(p[1] - p[0]);
+			tris.push_back(p[2] - p[0]);
+		}
+	}
+	buildBVH();
+
+	// one job per triangle of every instance: the charts never overlap
+	std::vector<glm::ivec2> jobs;
+	for(int j = 0; j < TI.InstanceCount; j++) {
+		int nt = SC->M[TI.I[j].Mid]->indices.size() / 3;
+		for(int t = 0; t < nt; t++) {
+			jobs.push_back(glm::ivec2(j, t));
+		}
+	}
+	std::vector<glm::vec3> E(width * height, glm::vec3(0.0f));
+	std::atomic<int> next(0);
+	const std::unordered_map<int, LightmapChart> &chartsOf = charts;	// read only by the workers
+
+	auto worker = [&]() {
+		for(int jb = next++; jb < jobs.size(); jb = next++) {
+			int j = jobs[jb].x, t = jobs[jb].y;
+			Model *M = SC->M[TI.I[j].Mid];
+			const LightmapChart &C = chartsOf.at(TI.I[j].Mid);
+			glm::mat4 &Wm = TI.I[j].Wm;
+			glm::mat3 Nm = glm::inverse(glm::transpose(glm::mat3(Wm)));
+
+			glm::vec3 P[3], Nv[3];
+			for(int k = 0; k < 3; k++) {
+				unsigned char *v = &M->vertices[(3 * t + k) * stride];
+				P[k] = glm::vec3(Wm * glm::vec4(*(glm::vec3 *)(v + VD->Position.offset), 1.0f));
+				Nv[k] = Nm * *(glm::vec3 *)(v + VD->Normal.offset);
+			}
+			glm::vec3 Ng = glm::cross(P[1] - P[0], P[2] - P[0]);
+			if(glm::length(Ng) <= 0.0f) {
+				continue;
+			}
+			Ng = glm::normalize(Ng);
+			float eps = 1e-3f * (1.0f + std::max(glm::length(P[1] - P[0]), glm::length(P[2] - P[0])));
+
+			glm::ivec4 r = C.rect[t];
+			glm::ivec2 o = glm::ivec2(pos[j]);
+			for(int y = r.y; y < r.y + r.w; y++) {
+				for(int x = r.x; x < r.x + r.z; x++) {
+					glm::vec3 b = lightmapClosestBarycentric(glm::vec2(x + 0.5f, y + 0.5f), C.q[3 * t], C.q[3 * t + 1], C.q[3 * t + 2]);
+					glm::vec3 p = b.x * P[0] + b.y * P[1] + b.z * P[2];
+					glm::vec3 n = b.x * Nv[0] + b.y * Nv[1] + b.z * Nv[2];
+					n = (glm::length(n) > 0.0f) ? glm::normalize(n) : Ng;
+					glm::vec3 org = p + (glm::dot(Ng, n) >= 0.0f ? Ng : -Ng) * eps;
+
+					glm::vec3 e(0.0f);
+					for(int l = 0; l < lightPosRadius.size(); l++) {
+						glm::vec3 L = glm::vec3(lightPosRadius[l]) - p;
+						float dist = glm::length(L);
+						float radius = lightPosRadius[l].w;
+						if((dist <= 0.0f) || (dist >= radius)) continue;
+						L /= dist;
+						float cosT = glm::dot(n, L);
+						if(cosT <= 0.0f) continue;
+						if(occluded(org, L, dist - eps)) continue;
+						float w = std::clamp(1.0f - (float)pow(dist / radius, 4.0f), 0.0f, 1.0f);
+						e += lightColor[l] * (float)pow(g / dist, decayFactor) * w * w * cosT;
+					}
+					E[(o.y + y) * width + o.x + x] = e;
+				}
+			}
+		}
+	};
+	int nThreads = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<std::thread> pool;
+	for(int i = 0; i < nThreads; i++) {
+		pool.emplace_back(worker);
+	}
+	for(auto &th : pool) {
+		th.join();
+	}
+
+	// RGBM encoding
+	std::vector<unsigned char> img(width * height * 4);
+	for(int i = 0; i < width * height; i++) {
+		glm::vec3 c = E[i] / LIGHTMAP_RGBM_RANGE;
+		float m = std::clamp(std::max(c.x, std::max(c.y, c.z)), 1e-6f, 1.0f);
+		m = ceil(m * 255.0f) / 255.0f;
+		c = glm::clamp(c / m, 0.0f, 1.0f);
+		img[4 * i + 0] = (unsigned char)lround(c.x * 255.0f);
+		img[4 * i + 1] = (unsigned char)lround(c.y * 255.0f);
+		img[4 * i + 2] = (unsigned char)lround(c.z * 255.0f);
+		img[4 * i + 3] = (unsigned char)lround(m * 255.0f);
+	}
+	std::filesystem::create_directories(cacheDir);
+	if(!stbi_write_png(file.c_str(), width, height, 4, img.data(), width * 4)) {
+		throw std::runtime_error("failed to write lightmap " + file);
+	}
+
+	auto endTime = std::chrono::high_resolution_clock::now();
+	std::cout << "Lightmap " << width << "x" << height << " baked in " <<
+		std::chrono::duration<float>(endTime - startTime).count() << " s with " << nThreads <<
+		" threads (" << tris.size() / 3 << " triangles): " << file << "\n";
+	return file;
+}
+
+#endif
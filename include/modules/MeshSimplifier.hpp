@@ -0,0 +1,286 @@
+// Levels of detail: simplified versions of the models, made by quadric error edge
+// collapses (Garland-Heckbert). Each vertex collapses onto one of its neighbors, so
+// all the levels share the vertex buffer of the model: they are only other ranges of
+// its index buffer (Model::LODs). Vertices on UV seams, hard edges (more than one
+// normal) and open borders never move.
+// The level of each instance is chosen by Scene::updateLODs()
+
+#define LOD_MAX_LEVELS 4			// full detail included
+#define LOD_MIN_TRIANGLES 64		// smaller meshes are not simplified
+
+struct MeshSimplifier {
+	float ratio = 0.5f;				// triangles of a level / triangles of the previous one
+	float maxError = 0.02f;			// max error of a collapse, relative to the model size
+	float minReduction = 0.8f;		// levels with more triangles than this * previous are dropped
+
+	void generateLODs(BaseProject *bp, Scene *SC, std::vector<TechniqueRef *> techniques);
+	int simplify(const unsigned char *V, int n, int stride, int posOff, int uvOff, int normOff,
+				 std::vector<uint32_t> &indices, std::vector<ModelLOD> &LODs, glm::vec4 &bounds);
+
+	private:
+	struct Quadric {
+		double a[10];			// upper triangle of the symmetric 4x4 matrix
+		double w;				// total area
+
+		void add(const Quadric &q);
+		double eval(glm::vec3 p);
+	};
+	struct Collapse {
+		int from, to;			// vertices
+		float cost;
+	};
+};
+
+#ifdef MESHSIMPLIFIER_IMPLEMENTATION
+
+void MeshSimplifier::Quadric::add(const Quadric &q) {
+	for(int i = 0; i < 10; i++) {
+		a[i] += q.a[i];
+	}
+	w += q.w;
+}
+
+// area weighted squared distance of p from the planes
+double MeshSimplifier::Quadric::eval(glm::vec3 p) {
+	double x = p.x, y = p.y, z = p.z;
+	return a[0]*x*x + 2*a[1]*x*y + 2*a[2]*x*z + 2*a[3]*x + a[4]*y*y + 2*a[5]*y*z + 2*a[6]*y +
+		   a[7]*z*z + 2*a[8]*z + a[9];
+}
+
+// Simplifies the models of the instances of the given techniques, and uploads them again
+// with their levels. Models that already have levels are skipped
+void MeshSimplifier::generateLODs(BaseProject *bp, Scene *SC, std::vector<TechniqueRef *> techniques) {
+	auto start = std::chrono::high_resolution_clock::now();
+	int models = 0;
+	for(int k = 0; k < SC->TechniqueInstanceCount; k++) {
+		TechniqueRef *Tr = SC->TI[k].T;
+		if(std::find(techniques.begin(), techniques.end(), Tr) == techniques.end()) {
+			continue;
+		}
+		VertexDescriptor *VD = Tr->VD;
+		if(!VD->Position.hasIt) {
+			continue;
+		}
+		int stride = VD->Bindings[0].stride;
+		for(int i = 0; i < SC->TI[k].InstanceCount; i++) {
+			Model *M = SC->M[SC->TI[k].I[i].Mid];
+			if(!M->LODs.empty()) {
+				continue;
+			}
+			int levels = simplify(M->vertices.data(), M->vertices.size() / stride, stride,
+								  VD->Position.offset, VD->UV.hasIt ? VD->UV.offset : -1,
+								  VD->Normal.hasIt ? VD->Normal.offset : -1,
+								  M->indices, M->LODs, M->bounds);
+			if(levels > 1) {
+				M->cleanup();
+				M->initMesh(bp, VD, false);
+				models++;
+			}
+		}
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	std::cout << "LODs generated for " << models << " models in " <<
+		std::chrono::duration<float, std::chrono::milliseconds::period>(end - start).count() << " ms\n";
+}
+
+// Appends the simplified levels to indices (of n vertices of stride bytes, with the
+// position and, if uvOff and normOff >= 0, the UV and the normal at the given offsets)
+// and fills LODs and bounds.
+// Returns the number of levels, full detail included
+int MeshSimplifier::simplify(const unsigned char *V, int n, int stride, int posOff, int uvOff, int normOff,
+							 std::vector<uint32_t> &indices, std::vector<ModelLOD> &LODs, glm::vec4 &bounds) {
+	auto P = [&](int v) {return *(const glm::vec3 *)(V + v * stride + posOff);};
+	auto T = [&](int v) {return uvOff >= 0 ? *(const glm::vec2 *)(V + v * stride + uvOff) : glm::vec2(0.0f);};
+	auto N = [&](int v) {return normOff >= 0 ? *(const glm::vec3 *)(V + v * stride + normOff) : glm::vec3(0.0f);};
+
+	glm::vec3 bmin(1e30f), bmax(-1e30f);
+	for(int v = 0; v < n; v++) {
+		bmin = glm::min(bmin, P(v));
+		bmax = glm::max(bmax, P(v));
+	}
+	float size = glm::length(bmax - bmin);
+	bounds = glm::vec4((bmin + bmax) * 0.5f, size * 0.5f);
+
+	LODs.clear();
+	LODs.push_back({0, static_cast<uint32_t>(indices.size()), 0.0f});
+	if(indices.size() / 3 < LOD_MIN_TRIANGLES) {
+		return 1;
+	}
+
+	// vertices with the same position, UV and normal are merged (the OBJ loader duplicates
+	// them), vertices with the same position only are the same point of the surface
+	auto sortBy = [&](bool attributes) {
+		std::vector<int> order(n), rep(n);
+		for(int v = 0; v < n; v++) order[v] = v;
+		auto key = [&](int v) {
+			glm::vec3 p = P(v);
+			glm::vec2 t = attributes ? T(v) : glm::vec2(0.0f);
+			glm::vec3 m = attributes ? N(v) : glm::vec3(0.0f);
+			return std::array<float, 8>{p.x, p.y, p.z, t.x, t.y, m.x, m.y, m.z};
+		};
+		std::sort(order.begin(), order.end(), [&](int a, int b) {return key(a) < key(b);});
+		for(int i = 0; i < n; i++) {
+			rep[order[i]] = ((i > 0) && (key(order[i]) == key(order[i - 1]))) ? rep[order[i - 1]] : order[i];
+		}
+		return rep;
+	};
+	std::vector<int> wedge = sortBy(true);
+	std::vector<int> point = sortBy(false);
+
+	std::vector<std::array<int, 3>> tris;
+	for(int i = 0; i + 2 < LODs[0].indexCount; i += 3) {
+		std::array<int, 3> t = {wedge[indices[i]], wedge[indices[i + 1]], wedge[indices[i + 2]]};
+		if((point[t[0]] != point[t[1]]) && (point[t[1]] != point[t[2]]) && (point[t[2]] != point[t[0]])) {
+			tris.push_back(t);
+		}
+	}
+
+	// seams: points with more than one UV or normal. Borders: edges of a single (or more than two) triangles
+	std::vector<bool> locked(n, false);
+	std::vector<int> wedgeOf(n, -1);
+	for(int v = 0; v < n; v++) {
+		if(wedge[v] == v) {
+			int p = point[v];
+			if((wedgeOf[p] >= 0) && (wedgeOf[p] != v)) {
+				locked[p] = true;
+			}
+			wedgeOf[p] = v;
+		}
+	}
+	std::unordered_map<uint64_t, int> edges;
+	auto edgeKey = [&](int a, int b) {
+		a = point[a]; b = point[b];
+		return ((uint64_t)std::min(a, b) << 32) | (uint64_t)std::max(a, b);
+	};
+	for(auto &t : tris) {
+		for(int e = 0; e < 3; e++) {
+			edges[edgeKey(t[e], t[(e + 1) % 3])]++;
+		}
+	}
+	for(auto &e : edges) {
+		if(e.second != 2) {
+			locked[e.first >> 32] = true;
+			locked[e.first & 0xffffffff] = true;
+		}
+	}
+
+	// quadrics and triangles of every point
+	std::vector<Quadric> Q(n, Quadric{});
+	std::vector<std::vector<int>> adj(n);
+	for(int ti = 0; ti < tris.size(); ti++) {
+		auto &t = tris[ti];
+		glm::vec3 c = glm::cross(P(t[1]) - P(t[0]), P(t[2]) - P(t[0]));
+		float area = glm::length(c) * 0.5f;
+		glm::vec3 nm = (area > 0.0f) ? c / (2.0f * area) : glm::vec3(0.0f);
+		double pl[4] = {nm.x, nm.y, nm.z, -glm::dot(nm, P(t[0]))};
+		Quadric q{};
+		int h = 0;
+		for(int i = 0; i < 4; i++) {
+			for(int j = i; j < 4; j++) {
+				q.a[h++] = area * pl[i] * pl[j];
+			}
+		}
+		q.w = area;
+		for(int k = 0; k < 3; k++) {
+			Q[point[t[k]]].add(q);
+			adj[point[t[k]]].push_back(ti);
+		}
+	}
+
+	std::vector<bool> dead(tris.size(), false);
+	int alive = tris.size();
+	float error = 0.0f;
+	float errorLimit = maxError * size;
+	std::vector<Collapse> C;
+	std::vector<bool> touched(n);
+
+	for(int level = 1; level < LOD_MAX_LEVELS; level++) {
+		int target = (int)(LODs.back().indexCount / 3 * ratio);
+		bool stuck = false;
+
+		while((alive > target) && !stuck) {
+			// one pass: cheapest collapses first, at most one per neighborhood
+			C.clear();
+			for(int ti = 0; ti < tris.size(); ti++) {
+				if(dead[ti]) continue;
+				for(int e = 0; e < 3; e++) {
+					int a = tris[ti][e], b = tris[ti][(e + 1) % 3];
+					for(int d = 0; d < 2; d++) {
+						if(!locked[point[a]]) {
+							Quadric q = Q[point[a]];
+							q.add(Q[point[b]]);
+							float cost = (q.w > 0.0) ? (float)sqrt(std::max(q.eval(P(b)) / q.w, 0.0)) : 0.0f;
+							C.push_back({a, b, cost});
+						}
+						std::swap(a, b);
+					}
+				}
+			}
+			std::sort(C.begin(), C.end(), [](const Collapse &x, const Collapse &y) {return x.cost < y.cost;});
+
+			std::fill(touched.begin(), touched.end(), false);
+			int done = 0;
+			for(auto &c : C) {
+				if(alive <= target) break;
+				if(c.cost > errorLimit) break;
+				int pa = point[c.from], pb = point[c.to];
+				if(touched[pa] || touched[pb]) continue;
+
+				// no triangle may flip
+				bool flips = false;
+				for(int ti : adj[pa]) {
+					if(dead[ti]) continue;
+					auto t = tris[ti];
+					if((point[t[0]] == pb) || (point[t[1]] == pb) || (point[t[2]] == pb)) continue;
+					glm::vec3 n0 = glm::cross(P(t[1]) - P(t[0]), P(t[2]) - P(t[0]));
+					for(int k = 0; k < 3; k++) {
+						if(point[t[k]] == pa) t[k] = c.to;
+					}
+					glm::vec3 n1 = glm::cross(P(t[1]) - P(t[0]), P(t[2]) - P(t[0]));
+					if(glm::dot(n0, n1) <= 0.25f * glm::length(n0) * glm::length(n1)) {
+						flips = true;
+						break;
+					}
+				}
+				if(flips) continue;
+
+				for(int ti : adj[pa]) {
+					if(dead[ti]) continue;
+					auto &t = tris[ti];
+					for(int k = 0; k < 3; k++) {
+						touched[point[t[k]]] = true;
+						if(point[t[k]] == pa) t[k] = c.to;
+					}
+					if((point[t[0]] == point[t[1]]) || (point[t[1]] == point[t[2]]) || (point[t[2]] == point[t[0]])) {
+						dead[ti] = true;
+						alive--;
+					} else {
+						adj[pb].push_back(ti);
+					}
+				}
+				adj[pa].clear();
+				Q[pb].add(Q[pa]);
+				error = std::max(error, c.cost);
+				done++;
+			}
+			stuck = (done == 0);
+		}
+
+		if(alive > LODs.back().indexCount / 3 * minReduction) {
+			break;
+		}
+		ModelLOD L = {static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(alive * 3), error};
+		for(int ti = 0; ti < tris.size(); ti++) {
+			if(!dead[ti]) {
+				indices.insert(indices.end(), tris[ti].begin(), tris[ti].end());
+			}
+		}
+		LODs.push_back(L);
+		if(stuck) {
+			break;
+		}
+	}
+	return LODs.size();
+}
+
+#endif
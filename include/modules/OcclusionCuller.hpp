@@ -0,0 +1,412 @@
+// Software occlusion culling: the instances marked "occluder" in scene.json (walls,
+// floor, wardrobes) are rasterized on the CPU into a small depth buffer, and the
+// bounding box of every "occludee" instance is tested against it before the draw calls
+// are recorded. Occluded instances are skipped (Instance::occluded).
+// The triangles are transformed and set up in chunks, then rasterized in horizontal
+// bands, by a pool of worker threads. The inner loops work on OCC_LANES pixels at a
+// time: 8 with AVX2 (when the compiler targets it, e.g. -mavx2), 4 with SSE2, 1 otherwise.
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define OCC_LANES 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define OCC_LANES 4
+#else
+#define OCC_LANES 1
+#endif
+
+#define OCC_WIDTH 320				// multiple of OCC_LANES
+#define OCC_HEIGHT 180
+#define OCC_BAND_ROWS 12			// rows rasterized by a job
+#define OCC_CHUNK_TRIANGLES 256		// triangles set up by a job
+#define OCC_NEAR_W 0.01f			// occluder triangles are clipped at this view depth
+
+struct OcclusionCuller {
+	Scene *SC;
+	bool enabled = true;
+	std::vector<float> depth;	// NDC depth of the nearest occluder, OCC_WIDTH x OCC_HEIGHT
+
+	// of the last update(), the times are averaged over the frames
+	int occluders = 0;
+	int occluderTriangles = 0;
+	int occludees = 0;
+	int occludedCount = 0;
+	float occluderMs = 0.0f;
+	float occludeeMs = 0.0f;
+
+	void init(Scene *sc, int threads = 0);
+	void destroy();
+	bool update(const glm::mat4 &ViewPrj);
+
+	private:
+	struct OccTriangle {
+		float x[3], y[3];			// screen, counter clockwise
+		float zA, zB, zC;			// depth plane: zA * x + zB * y + zC
+		int minX, maxX, minY, maxY;
+	};
+	struct OccChunk {
+		Instance *I;
+		int firstTriangle, count;
+	};
+
+	std::vector<Instance *> occluderList, occludeeList;
+	std::vector<OccChunk> chunks;
+	std::vector<std::vector<OccTriangle>> setupTriangles;	// per worker
+	glm::mat4 VP;
+
+	// worker pool: run() starts a phase on all the workers and waits for them
+	enum {OCC_SETUP, OCC_RASTER};
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable startCV, doneCV;
+	int phase = OCC_SETUP;
+	int generation = 0;
+	int running = 0;
+	bool quit = false;
+	std::atomic<int> nextJob;
+
+	void run(int ph);
+	void worker(int t);
+	void setup(int t, const OccChunk &C);
+	void raster(int y0, int y1);
+	bool visible(glm::vec4 sphere);
+};
+
+#ifdef OCCLUSIONCULLER_IMPLEMENTATION
+
+// Lane helpers: a mask lane is all ones (SIMD) or 1.0f (scalar) when true
+#if OCC_LANES == 8
+typedef __m256 occFloat;
+static inline occFloat occSet(float f) {return _mm256_set1_ps(f);}
+static inline occFloat occRamp() {return _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);}
+static inline occFloat occLoad(const float *p) {return _mm256_loadu_ps(p);}
+static inline void occStore(float *p, occFloat v) {_mm256_storeu_ps(p, v);}
+static inline occFloat occAdd(occFloat a, occFloat b) {return _mm256_add_ps(a, b);}
+static inline occFloat occMul(occFloat a, occFloat b) {return _mm256_mul_ps(a, b);}
+static inline occFloat occMin(occFloat a, occFloat b) {return _mm256_min_ps(a, b);}
+static inline occFloat occGE(occFloat a, occFloat b) {return _mm256_cmp_ps(a, b, _CMP_GE_OQ);}
+static inline occFloat occAnd(occFloat a, occFloat b) {return _mm256_and_ps(a, b);}
+static inline occFloat occSelect(occFloat m, occFloat a, occFloat b) {return _mm256_blendv_ps(b, a, m);}
+static inline bool occAny(occFloat m) {return _mm256_movemask_ps(m) != 0;}
+#elif OCC_LANES == 4
+typedef __m128 occFloat;
+static inline occFloat occSet(float f) {return _mm_set1_ps(f);}
+static inline occFloat occRamp() {return _mm_setr_ps(0, 1, 2, 3);}
+static inline occFloat occLoad(const float *p) {return _mm_loadu_ps(p);}
+static inline void occStore(float *p, occFloat v) {_mm_storeu_ps(p, v);}
+static inline occFloat occAdd(occFloat a, occFloat b) {return _mm_add_ps(a, b);}
+static inline occFloat occMul(occFloat a, occFloat b) {return _mm_mul_ps(a, b);}
+static inline occFloat occMin(occFloat a, occFloat b) {return _mm_min_ps(a, b);}
+static inline occFloat occGE(occFloat a, occFloat b) {return _mm_cmpge_ps(a, b);}
+static inline occFloat occAnd(occFloat a, occFloat b) {return _mm_and_ps(a, b);}
+static inline occFloat occSelect(occFloat m, occFloat a, occFloat b) {return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));}
+static inline bool occAny(occFloat m) {return _mm_movemask_ps(m) != 0;}
+#else
+typedef float occFloat;
+static inline occFloat occSet(float f) {return f;}
+static inline occFloat occRamp() {return 0.0f;}
+static inline occFloat occLoad(const float *p) {return *p;}
+static inline void occStore(float *p, occFloat v) {*p = v;}
+static inline occFloat occAdd(occFloat a, occFloat b) {return a + b;}
+static inline occFloat occMul(occFloat a, occFloat b) {return a * b;}
+static inline occFloat occMin(occFloat a, occFloat b) {return std::min(a, b);}
+static inline occFloat occGE(occFloat a, occFloat b) {return (a >= b) ? 1.0f : 0.0f;}
+static inline occFloat occAnd(occFloat a, occFloat b) {return a * b;}
+static inline occFloat occSelect(occFloat m, occFloat a, occFloat b) {return (m != 0.0f) ? a : b;}
+static inline bool occAny(occFloat m) {return m != 0.0f;}
+#endif
+
+// To be called after the scene has been loaded (and batched). threads = 0: one less than the cores
+void OcclusionCuller::init(Scene *sc, int threads) {
+	SC = sc;
+	depth.assign(OCC_WIDTH * OCC_HEIGHT, 1e30f);
+
+	for(int k = 0; k < SC->TechniqueInstanceCount; k++) {
+		for(int i = 0; i < SC->TI[k].InstanceCount; i++) {
+			Instance *I = &SC->TI[k].I[i];
+			if(I->occluder) {
+				occluderList.push_back(I);
+			}
+			// the static batches are drawn as a whole
+			if(I->occludee && (I->batch == nullptr)) {
+				occludeeList.push_back(I);
+			}
+		}
+	}
+
+	if(threads <= 0) {
+		threads = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+	}
+	setupTriangles.resize(threads);
+	for(int t = 0; t < threads; t++) {
+		workers.emplace_back(&OcclusionCuller::worker, this, t);
+	}
+	std::cout << "Occlusion culling: " << occluderList.size() << " occluders, " << occludeeList.size() <<
+				 " occludees, " << threads << " threads, " << OCC_LANES << " lanes\n";
+}
+
+void OcclusionCuller::destroy() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		quit = true;
+	}
+	startCV.notify_all();
+	for(auto &w : workers) {
+		w.join();
+	}
+	workers.clear();
+}
+
+void OcclusionCuller::run(int ph) {
+	std::unique_lock<std::mutex> lock(mutex);
+	phase = ph;
+	nextJob = 0;
+	running = workers.size();
+	generation++;
+	startCV.notify_all();
+	doneCV.wait(lock, [&] {return running == 0;});
+}
+
+void OcclusionCuller::worker(int t) {
+	int seen = 0;
+	while(true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			startCV.wait(lock, [&] {return quit || (generation != seen);});
+			if(quit) {
+				return;
+			}
+			seen = generation;
+		}
+		if(phase == OCC_SETUP) {
+			setupTriangles[t].clear();
+			for(int j = nextJob++; j < chunks.size(); j = nextJob++) {
+				setup(t, chunks[j]);
+			}
+		} else {
+			for(int j = nextJob++; j * OCC_BAND_ROWS < OCC_HEIGHT; j = nextJob++) {
+				raster(j * OCC_BAND_ROWS, std::min((j + 1) * OCC_BAND_ROWS, OCC_HEIGHT));
+			}
+		}
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			running--;
+		}
+		doneCV.notify_one();
+	}
+}
+
+// Transforms, clips at OCC_NEAR_W and sets up the triangles of a chunk
+void OcclusionCuller::setup(int t, const OccChunk &C) {
+	Model *M = SC->M[C.I->Mid];
+	VertexDescriptor *VD = C.I->TIp->T->VD;
+	int stride = VD->Bindings[0].stride;
+	glm::mat4 MVP = VP * C.I->Wm;
+
+	for(int tri = C.firstTriangle; tri < C.firstTriangle + C.count; tri++) {
+		glm::vec4 P[3];
+		int behind = 0;
+		for(int k = 0; k < 3; k++) {
+			uint32_t v = M->indices[3 * tri + k];
+			P[k] = MVP * glm::vec4(*(glm::vec3 *)(&M->vertices[v * stride + VD->Position.offset]), 1.0f);
+			behind += (P[k].w < OCC_NEAR_W) ? 1 : 0;
+		}
+		if(behind == 3) {
+			continue;
+		}
+
+		// clipping against the near plane: at most a quad
+		glm::vec4 Q[4];
+		int n = 0;
+		for(int k = 0; k < 3; k++) {
+			const glm::vec4 &a = P[k], &b = P[(k + 1) % 3];
+			if(a.w >= OCC_NEAR_W) {
+				Q[n++] = a;
+			}
+			if((a.w >= OCC_NEAR_W) != (b.w >= OCC_NEAR_W)) {
+				Q[n++] = a + (b - a) * ((OCC_NEAR_W - a.w) / (b.w - a.w));
+			}
+		}
+
+		float sx[4], sy[4], sz[4];
+		for(int k = 0; k < n; k++) {
+			sx[k] = (Q[k].x / Q[k].w * 0.5f + 0.5f) * OCC_WIDTH;
+			sy[k] = (Q[k].y / Q[k].w * 0.5f + 0.5f) * OCC_HEIGHT;
+			sz[k] = Q[k].z / Q[k].w;
+		}
+		for(int f = 1; f + 1 < n; f++) {
+			int id[3] = {0, f, f + 1};
+			float area = (sx[id[1]] - sx[id[0]]) * (sy[id[2]] - sy[id[0]]) -
+						 (sx[id[2]] - sx[id[0]]) * (sy[id[1]] - sy[id[0]]);
+			if(fabs(area) < 1e-8f) {
+				continue;
+			}
+			if(area < 0.0f) {
+				std::swap(id[1], id[2]);
+				area = -area;
+			}
+			OccTriangle T;
+			for(int k = 0; k < 3; k++) {
+				T.x[k] = sx[id[k]];
+				T.y[k] = sy[id[k]];
+			}
+			// plane through the three (x, y, z)
+			float dz1 = sz[id[1]] - sz[id[0]], dz2 = sz[id[2]] - sz[id[0]];
+			float dx1 = T.x[1] - T.x[0], dx2 = T.x[2] - T.x[0];
+			float dy1 = T.y[1] - T.y[0], dy2 = T.y[2] - T.y[0];
+			T.zA = (dz1 * dy2 - dz2 * dy1) / area;
+			T.zB = (dx1 * dz2 - dx2 * dz1) / area;
+			T.zC = sz[id[0]] - T.zA * T.x[0] - T.zB * T.y[0];
+
+			T.minX = std::max((int)floor(std::min(T.x[0], std::min(T.x[1], T.x[2]))), 0);
+			T.maxX = std::min((int)ceil(std::max(T.x[0], std::max(T.x[1], T.x[2]))), OCC_WIDTH - 1);
+			T.minY = std::max((int)floor(std::min(T.y[0], std::min(T.y[1], T.y[2]))), 0);
+			T.maxY = std::min((int)ceil(std::max(T.y[0], std::max(T.y[1], T.y[2]))), OCC_HEIGHT - 1);
+			if((T.minX <= T.maxX) && (T.minY <= T.maxY)) {
+				setupTriangles[t].push_back(T);
+			}
+		}
+	}
+}
+
+// Rasterizes all the set up triangles in rows [y0, y1), pixel centers only
+void OcclusionCuller::raster(int y0, int y1) {
+	const occFloat ramp = occRamp();
+	const occFloat zero = occSet(0.0f);
+	for(auto &list : setupTriangles) {
+		for(const OccTriangle &T : list) {
+			int ty0 = std::max(T.minY, y0), ty1 = std::min(T.maxY, y1 - 1);
+			if(ty0 > ty1) {
+				continue;
+			}
+			// edge functions: A * x + B * y + C >= 0 inside
+			float A[3], B[3], C[3];
+			for(int e = 0; e < 3; e++) {
+				int f = (e + 1) % 3;
+				A[e] = T.y[e] - T.y[f];
+				B[e] = T.x[f] - T.x[e];
+				C[e] = -(A[e] * T.x[e] + B[e] * T.y[e]);
+			}
+			int x0 = T.minX - (T.minX % OCC_LANES);
+			for(int y = ty0; y <= ty1; y++) {
+				float py = y + 0.5f;
+				float *row = &depth[y * OCC_WIDTH];
+				for(int x = x0; x <= T.maxX; x += OCC_LANES) {
+					occFloat px = occAdd(occSet(x + 0.5f), ramp);
+					occFloat in = occGE(occAdd(occMul(occSet(A[0]), px), occSet(B[0] * py + C[0])), zero);
+					in = occAnd(in, occGE(occAdd(occMul(occSet(A[1]), px), occSet(B[1] * py + C[1])), zero));
+					in = occAnd(in, occGE(occAdd(occMul(occSet(A[2]), px), occSet(B[2] * py + C[2])), zero));
+					if(!occAny(in)) {
+						continue;
+					}
+					occFloat z = occAdd(occMul(occSet(T.zA), px), occSet(T.zB * py + T.zC));
+					occFloat d = occLoad(row + x);
+					occStore(row + x, occSelect(in, occMin(d, z), d));
+				}
+			}
+		}
+	}
+}
+
+// Conservative: the box around the sphere is visible if it is not entirely in front
+// of the near plane, or if any pixel of its screen rectangle is farther than its
+// nearest point
+bool OcclusionCuller::visible(glm::vec4 s) {
+	float minX = 1e30f, maxX = -1e30f, minY = 1e30f, maxY = -1e30f, minZ = 1e30f;
+	for(int c = 0; c < 8; c++) {
+		glm::vec3 p = glm::vec3(s) + glm::vec3((c & 1) ? s.w : -s.w, (c & 2) ? s.w : -s.w, (c & 4) ? s.w : -s.w);
+		glm::vec4 q = VP * glm::vec4(p, 1.0f);
+		if(q.w < OCC_NEAR_W) {
+			return true;
+		}
+		float x = (q.x / q.w * 0.5f + 0.5f) * OCC_WIDTH;
+		float y = (q.y / q.w * 0.5f + 0.5f) * OCC_HEIGHT;
+		minX = std::min(minX, x);
+		maxX = std::max(maxX, x);
+		minY = std::min(minY, y);
+		maxY = std::max(maxY, y);
+		minZ = std::min(minZ, q.z / q.w);
+	}
+	int x0 = std::max((int)floor(minX), 0), x1 = std::min((int)ceil(maxX), OCC_WIDTH - 1);
+	int y0 = std::max((int)floor(minY), 0), y1 = std::min((int)ceil(maxY), OCC_HEIGHT - 1);
+	if((x0 > x1) || (y0 > y1)) {
+		return true;	// off screen: left to the clipper
+	}
+
+	const occFloat ramp = occRamp();
+	const occFloat lo = occSet((float)x0), hi = occSet((float)x1), z = occSet(minZ);
+	for(int y = y0; y <= y1; y++) {
+		const float *row = &depth[y * OCC_WIDTH];
+		for(int x = x0 - (x0 % OCC_LANES); x <= x1; x += OCC_LANES) {
+			occFloat px = occAdd(occSet((float)x), ramp);
+			occFloat m = occAnd(occAnd(occGE(px, lo), occGE(hi, px)), occGE(occLoad(row + x), z));
+			if(occAny(m)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+// Sets Instance::occluded for the occludees seen with ViewPrj. Returns true if any
+// changed: the command buffers must be recorded again
+bool OcclusionCuller::update(const glm::mat4 &ViewPrj) {
+	VP = ViewPrj;
+	if(!enabled) {
+		bool changed = false;
+		for(Instance *I : occludeeList) {
+			changed = changed || I->occluded;
+			I->occluded = false;
+		}
+		occludedCount = 0;
+		return changed;
+	}
+
+	auto t0 = std::chrono::high_resolution_clock::now();
+	std::fill(depth.begin(), depth.end(), 1e30f);
+	chunks.clear();
+	occluders = 0;
+	for(Instance *I : occluderList) {
+		if(!I->occluder) {
+			continue;	// e.g. deleted
+		}
+		occluders++;
+		int nt = SC->M[I->Mid]->getLOD(0).indexCount / 3;		// full detail, conservative
+		for(int f = 0; f < nt; f += OCC_CHUNK_TRIANGLES) {
+			chunks.push_back({I, f, std::min(OCC_CHUNK_TRIANGLES, nt - f)});
+		}
+	}
+	run(OCC_SETUP);
+	occluderTriangles = 0;
+	for(auto &list : setupTriangles) {
+		occluderTriangles += list.size();
+	}
+	run(OCC_RASTER);
+
+	auto t1 = std::chrono::high_resolution_clock::now();
+	bool changed = false;
+	occludees = 0;
+	occludedCount = 0;
+	for(Instance *I : occludeeList) {
+		Model *M = SC->M[I->Mid];
+		glm::vec4 b = M->getBounds();
+		const glm::mat4 &Wm = I->Wm;
+		float scale = std::max(glm::length(glm::vec3(Wm[0])),
+					  std::max(glm::length(glm::vec3(Wm[1])), glm::length(glm::vec3(Wm[2]))));
+		bool occ = !visible(glm::vec4(glm::vec3(Wm * glm::vec4(glm::vec3(b), 1.0f)), b.w * scale));
+		changed = changed || (occ != I->occluded);
+		I->occluded = occ;
+		occludees++;
+		occludedCount += occ ? 1 : 0;
+	}
+	auto t2 = std::chrono::high_resolution_clock::now();
+
+	float a = std::chrono::duration<float, std::chrono::milliseconds::period>(t1 - t0).count();
+	float b = std::chrono::duration<float, std::chrono::milliseconds::period>(t2 - t1).count();
+	occluderMs = (occluderMs == 0.0f) ? a : occluderMs * 0.95f + a * 0.05f;
+	occludeeMs = (occludeeMs == 0.0f) ? b : occludeeMs * 0.95f + b * 0.05f;
+	return changed;
+}
+
+#endif
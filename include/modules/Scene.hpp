@@ -1,20 +1,68 @@
+#include "InstanceStore.hpp"
 
 struct TechniqueInstances;
+struct StaticBatch;
 
 struct Instance {
 	std::string *id;
+	int name;			// id interned at load (Scene::intern), equal for the instances with the same id
 	int Mid;
+	int mat;			// position in Scene::Mat
 	int NTx;
-	int Iid;
-	int *Tid;
+	int Iid;			// handle: position in Scene::I and in Scene::store
+	int *Tid;			// the textures of its material
 	DescriptorSet ***DS;
 	std::vector<DescriptorSetLayout *> **D;
 	int *NDs;
 	
-	glm::mat4 Wm;
+	int parent;			// handle of the "parent" of scene.json, -1 for the roots
+	glm::vec3 pos;		// local transform, relative to the parent: see Scene::setLocal()
+	glm::quat rot;
+	glm::vec3 scl;
+	bool localChanged;	// Wm to be computed again by Scene::updateTransforms()
+	glm::mat4 Wm;		// world matrix: parent Wm * local transform
+	glm::mat4 Nm;		// normal matrix of Wm, see Scene::normalMatrix()
+	bool NmValid;
+	uint32_t dirtyImages;	// one bit per swap chain image whose uniforms are out of date
 	TechniqueInstances *TIp;
+	int lod;
+	bool culled;		// not drawn, e.g. not visible through the portals (CellPortals)
+	bool occluder;		// "occluder" and "occludee" of scene.json (OcclusionCuller)
+	bool occludee;
+	bool occluded;		// not drawn, hidden by the occluders
+	bool isStatic;		// "static" of scene.json: never moves, merged in a StaticBatch
+	StaticBatch *batch;	// drawn by this batch, not by itself
+	bool spawned;		// added by Scene::addInstance(), at spawnPos in Scene::spawned
+	int spawnPos;
 } ;
 
+#define SPAWN_CHUNK 256		// descriptor sets per pool of the instances added at run time
+
+// A descriptor pool for SPAWN_CHUNK sets of a layout, with one buffer for their uniforms
+struct SpawnChunk {
+	DescriptorSetLayout *DSL;
+	VkDescriptorPool pool;
+	VkBuffer buffer;
+	VkDeviceMemory memory;
+	VkDeviceSize slotSize;
+	int used;
+} ;
+
+// Static instances of a technique with the same material, merged into a single model
+// pre-transformed in world space: one draw call, with the descriptor sets of the first
+// of them (leader), whose uniforms are written once with an identity world matrix.
+// The vertex shaders of the technique must read the view-projection from the global set
+struct StaticBatch {
+	TechniqueInstances *TIp;
+	Instance *leader;
+	std::vector<Instance *> members;
+	Model *M;
+} ;
+
+// Called on the vertices of each instance merged in a static batch, after they have been
+// moved to world space, for the attributes that the scene does not know (e.g. lightmap UVs)
+typedef void (*pStaticVertexFunc)(Instance *I, unsigned char *vertices, int count, void *params);
+
 struct TextureDefs {
 	bool fromInstance;
 	int pos;
@@ -31,8 +79,25 @@ struct TechniqueRef {
 	std::vector<PipelineAndTexturesDefs>PT;
 	int Ntextures;
 	VertexDescriptor *VD;
+	int materialSet;	// set allocated once per material instead of per instance, -1 if none
+	// stages that receive the position of the material in Scene::Mat as a uint32 push
+	// constant at offset 0 (e.g. to index a table of all the materials), 0 if none
+	VkShaderStageFlags materialPush = 0;
 
-	void init(const char *_id, std::vector<PipelineAndTexturesDefs> _PT, int _Ntextures, VertexDescriptor * _VD);
+	void init(const char *_id, std::vector<PipelineAndTexturesDefs> _PT, int _Ntextures, VertexDescriptor * _VD,
+			  int _materialSet = -1);
+} ;
+
+// A technique with its textures and constants (the "materials" of scene.json): the
+// set TechniqueRef::materialSet is allocated once and shared by all its instances,
+// which are drawn next to each other (see Scene::populateCommandBuffer)
+struct Material {
+	std::string *id;
+	TechniqueRef *T;
+	std::vector<int> Tid;
+	float gamma;
+	glm::vec3 specularColor;
+	std::vector<DescriptorSet *> DS;	// per pass, the set materialSet
 } ;
 
 struct VertexDescriptorRef {
@@ -71,13 +136,22 @@ class Scene {
 	int TextureCount = 0;
 	Texture **T;
 	std::unordered_map<std::string, int> TextureIds;
+
+	// Materials, explicit or made for the instances that list their textures
+	std::vector<Material *> Mat;
+	std::unordered_map<std::string, int> MaterialIds;
 	
 	// Descriptor sets and instances
 	int InstanceCount = 0;
 
 	Instance **I;
 	VertexDescriptorRef *VRef;
-	std::unordered_map<std::string, int> InstanceIds;
+
+	// The ids of scene.json are interned at load: strings are only used to resolve them
+	// once (findInstance) and for printing, the frame code works with the handles
+	std::vector<std::string> Names;
+	std::unordered_map<std::string, int> NameIds;
+	std::vector<int> NameFirst;		// handle of the first instance with each name
 
 	// Pipelines, DSL and Vertex Formats
 	std::unordered_map<std::string, TechniqueRef *> TechniqueIds;
@@ -86,22 +160,124 @@ class Scene {
 	std::unordered_map<std::string, VertexDescriptor *> VDIds;
 	int Npasses;
 
+	// World matrices and bounds of all the instances, kept in sync by setTransform()
+	InstanceStore store;
+
+	// Descriptor sets owned by the application and used by all the instances
+	// for a given layout (e.g. the global set): they are not allocated per instance
+	std::unordered_map<DescriptorSetLayout *, DescriptorSet *> SharedDS;
+
+	// Levels of detail (see MeshSimplifier), and triangles drawn per pass
+	bool useLODs = true;
+	int trianglesDrawn = 0;
+	int trianglesFull = 0;
+
+	// Merged models of the static instances (see buildStaticBatches)
+	std::vector<StaticBatch *> batches;
+
+	// Visibility and selection, one bit per instance handle
+	std::vector<uint64_t> hiddenBits;
+	std::vector<uint64_t> selectedBits;
 
+	int intern(const std::string &name);
+	int findInstance(const std::string &id);
+	void setHidden(int h, bool hidden);
+	bool isHidden(int h) const;
+	void setSelected(int h, bool selected);
+	bool isSelected(int h) const;
+	void clearSelection();
+
+	// Scene graph: the instances sorted breadth first, the parents before their children
+	// and the children of an instance next to each other (see updateTransforms)
+	std::vector<int> graphOrder;		// handles
+	std::vector<int> graphRank;			// position of each handle in graphOrder
+	std::vector<int> firstChild;		// per handle, position of its first child in graphOrder
+	std::vector<int> childCount;
+	std::vector<int> changedLocals;		// handles changed since the last updateTransforms()
+	int transformsUpdated = 0;			// world matrices computed by the last update
+
+	void setLocal(Instance *inst, glm::vec3 pos, glm::quat rot, glm::vec3 scl);
+	void moveBy(Instance *inst, glm::vec3 d);
+	glm::mat4 parentWorld(Instance *inst);
+	int updateTransforms();
+	static void decompose(const glm::mat4 &L, Instance *inst);
+
+	// Per instance uniforms are uploaded only after a change (see takeDirty)
+	void setTransform(Instance *inst, const glm::mat4 &Wm);
+	void markDirty(Instance *inst);
+	void markAllDirty();
+	bool takeDirty(Instance *inst, int currentImage);
+	const glm::mat4 &normalMatrix(Instance *inst);
+
+	void shareDescriptorSet(DescriptorSetLayout *DSL, DescriptorSet *DS);
+	int reusedSetPass(TechniqueRef *Tr, int ipas, int j);
 	int init(BaseProject *_BP,  int _Npasses, std::vector<VertexDescriptorRef>  &VDRs, std::vector<TechniqueRef> &PRs, std::string file);
+	int addMaterial(const std::string &id, TechniqueRef *Tr, const std::vector<int> &Tid,
+					float gamma, glm::vec3 specularColor);
+
+	// The sets of the materials and of the instances of the scene file are created
+	// together (DescriptorSetBatch), or one by one with bulkDescriptorSets false
+	bool bulkDescriptorSets = true;
+	int descriptorSetsCreated = 0;		// by the last pipelinesAndDescriptorSetsInit()
+	double descriptorSetsMs = 0.0;
 
 	void pipelinesAndDescriptorSetsInit();
 	void pipelinesAndDescriptorSetsCleanup();
 	void localCleanup();
     void populateCommandBuffer(VkCommandBuffer commandBuffer, int passId, int currentImage);
+	bool updateLODs(glm::vec3 eye, float pixelScale);
+	void buildStaticBatches(pStaticVertexFunc fixVertices = nullptr, void *params = nullptr);
+
+	// Instances added and removed at run time: handles from InstanceCount to HandleCount,
+	// (the free ones have TIp == nullptr). Their descriptor sets come from pools of
+	// SPAWN_CHUNK sets and their uniforms from slots of one buffer per pool; the sets of
+	// the removed instances are reused, once the frames that could draw them are done
+	int HandleCount = 0;
+	std::vector<std::vector<Instance *>> spawned;	// [technique]
+	int spawnedCount = 0;
+	int spawnSetsAllocated = 0;		// statistics
+	int spawnSetsReused = 0;
+
+	int addInstance(int mat, int Mid, const std::string &id, glm::vec3 pos, glm::quat rot, glm::vec3 scl);
+	bool removeInstance(int h);
+	void recycle();
+	int spawnChunkCount() const;
+
+	private:
+	std::vector<int> freeHandles;
+	std::vector<SpawnChunk> chunks;
+	std::unordered_map<DescriptorSetLayout *, int> openChunk;
+	std::unordered_map<DescriptorSetLayout *, std::vector<DescriptorSet *>> freeSets;
+	std::vector<std::pair<int, DescriptorSet *>> retiredSets;	// frame of the removal
+	int frame = 0;
+	int handleCapacity = 0;
+	DescriptorSetBatch setBatch;
+
+	// [technique instances], the batches as their leaders, sorted by material and model
+	std::vector<std::vector<Instance *>> drawOrder;
+	bool drawOrderValid = false;
+
+	std::vector<VkDescriptorImageInfo> textureInfos(TechniqueRef *Tr, const int *Tid, int ipas, int j);
+	void sortDraws();
+	bool ownsSet(Instance *inst, int ipas, int j);
+	void allocateSpawnedSets(Instance *inst);
+	void releaseSpawnedSets(Instance *inst, bool reuse);
+	DescriptorSet *spawnSet(DescriptorSetLayout *DSL, const std::vector<VkDescriptorImageInfo> &Tids);
+	DescriptorSet *createSet(DescriptorSetLayout *DSL, const std::vector<VkDescriptorImageInfo> &Tids);
+	void destroySpawnPools();
+	void buildGraph(const std::vector<std::string> &parentIds);
+	static glm::mat4 localMatrix(Instance *inst);
 };
 
 #ifdef SCENE_IMPLEMENTATION
 
-void TechniqueRef::init(const char *_id, std::vector<PipelineAndTexturesDefs> _PT, int _Ntextures, VertexDescriptor * _VD) {
+void TechniqueRef::init(const char *_id, std::vector<PipelineAndTexturesDefs> _PT, int _Ntextures, VertexDescriptor * _VD,
+						int _materialSet) {
 	id = new std::string(_id);
 	PT = _PT;
 	Ntextures = _Ntextures;
 	VD = _VD;
+	materialSet = _materialSet;
 }
 
 void VertexDescriptorRef::init(const char *_id, VertexDescriptor * _VD) {
@@ -109,6 +285,268 @@ void VertexDescriptorRef::init(const char *_id, VertexDescriptor * _VD) {
 	VD = _VD;
 }
 
+int Scene::intern(const std::string &name) {
+	auto it = NameIds.find(name);
+	if(it != NameIds.end()) {
+		return it->second;
+	}
+	Names.push_back(name);
+	NameFirst.push_back(-1);
+	NameIds[name] = Names.size() - 1;
+	return Names.size() - 1;
+}
+
+// Handle of the (first) instance with that id of scene.json, -1 if there is none.
+// To be called at load time, not every frame
+int Scene::findInstance(const std::string &id) {
+	auto it = NameIds.find(id);
+	return (it == NameIds.end()) ? -1 : NameFirst[it->second];
+}
+
+void Scene::setHidden(int h, bool hidden) {
+	uint64_t bit = 1ull << (h & 63);
+	if(isHidden(h) != hidden) {
+		hiddenBits[h >> 6] ^= bit;
+		markDirty(I[h]);
+	}
+}
+
+bool Scene::isHidden(int h) const {
+	return (hiddenBits[h >> 6] >> (h & 63)) & 1;
+}
+
+void Scene::setSelected(int h, bool selected) {
+	uint64_t bit = 1ull << (h & 63);
+	if(isSelected(h) != selected) {
+		selectedBits[h >> 6] ^= bit;
+		markDirty(I[h]);
+	}
+}
+
+bool Scene::isSelected(int h) const {
+	return (selectedBits[h >> 6] >> (h & 63)) & 1;
+}
+
+void Scene::clearSelection() {
+	for(int w = 0; w < selectedBits.size(); w++) {
+		if(selectedBits[w] == 0) {
+			continue;
+		}
+		for(int h = w * 64; h < std::min(w * 64 + 64, HandleCount); h++) {
+			if(isSelected(h)) {
+				markDirty(I[h]);
+			}
+		}
+		selectedBits[w] = 0;
+	}
+}
+
+// World matrix Wm for inst: stored as the local transform that gives it, applied
+// (with the children) by the next updateTransforms()
+void Scene::setTransform(Instance *inst, const glm::mat4 &Wm) {
+	Instance L = *inst;
+	decompose(glm::inverse(parentWorld(inst)) * Wm, &L);
+	setLocal(inst, L.pos, L.rot, L.scl);
+}
+
+void Scene::setLocal(Instance *inst, glm::vec3 pos, glm::quat rot, glm::vec3 scl) {
+	if((inst->pos == pos) && (inst->rot == rot) && (inst->scl == scl)) {
+		return;
+	}
+	inst->pos = pos;
+	inst->rot = rot;
+	inst->scl = scl;
+	if(!inst->localChanged) {
+		inst->localChanged = true;
+		changedLocals.push_back(inst->Iid);
+	}
+}
+
+// Moves inst by d in world space, whatever the transform of its parent
+void Scene::moveBy(Instance *inst, glm::vec3 d) {
+	glm::vec3 dl = glm::vec3(glm::inverse(parentWorld(inst)) * glm::vec4(d, 0.0f));
+	setLocal(inst, inst->pos + dl, inst->rot, inst->scl);
+}
+
+glm::mat4 Scene::parentWorld(Instance *inst) {
+	return (inst->parent < 0) ? glm::mat4(1.0f) : I[inst->parent]->Wm;
+}
+
+glm::mat4 Scene::localMatrix(Instance *inst) {
+	return glm::translate(glm::mat4(1.0f), inst->pos) *
+		   glm::mat4(inst->rot) *
+		   glm::scale(glm::mat4(1.0f), inst->scl);
+}
+
+// Translation, rotation and scale of L (no shear): a negative determinant is a mirror on x
+void Scene::decompose(const glm::mat4 &L, Instance *inst) {
+	glm::vec3 s(glm::length(glm::vec3(L[0])), glm::length(glm::vec3(L[1])), glm::length(glm::vec3(L[2])));
+	if(glm::determinant(glm::mat3(L)) < 0.0f) {
+		s.x = -s.x;
+	}
+	glm::mat3 R(glm::vec3(L[0]) / s.x, glm::vec3(L[1]) / s.y, glm::vec3(L[2]) / s.z);
+	inst->pos = glm::vec3(L[3]);
+	inst->rot = glm::normalize(glm::quat_cast(R));
+	inst->scl = s;
+}
+
+// Computes again the world matrices of the instances whose local transform has changed,
+// and of their descendants. Each changed subtree is visited breadth first, starting from
+// the changed instance closest to the root; only the instances whose world matrix is
+// different are marked dirty (and uploaded). Returns the number of matrices computed
+int Scene::updateTransforms() {
+	transformsUpdated = 0;
+	if(changedLocals.empty()) {
+		return 0;
+	}
+	std::sort(changedLocals.begin(), changedLocals.end(),
+			  [&](int a, int b) {return graphRank[a] < graphRank[b];});
+
+	std::vector<int> queue;
+	for(int h : changedLocals) {
+		if(!I[h]->localChanged) {
+			continue;		// done with an ancestor
+		}
+		queue.assign(1, h);
+		for(int q = 0; q < queue.size(); q++) {
+			int c = queue[q];
+			Instance *inst = I[c];
+			inst->localChanged = false;
+			glm::mat4 Wm = parentWorld(inst) * localMatrix(inst);
+			transformsUpdated++;
+			if(Wm == inst->Wm) {
+				continue;	// the children have not moved either
+			}
+			inst->Wm = Wm;
+			store.setWorld(c, Wm);
+			markDirty(inst);
+			for(int g = firstChild[c]; g < firstChild[c] + childCount[c]; g++) {
+				queue.push_back(graphOrder[g]);
+			}
+		}
+	}
+	changedLocals.clear();
+	return transformsUpdated;
+}
+
+// Resolves the parents and sorts the instances breadth first, then computes all the
+// world matrices. To be called at load time, before the store is filled
+void Scene::buildGraph(const std::vector<std::string> &parentIds) {
+	std::vector<std::vector<int>> children(InstanceCount);
+	std::vector<int> roots;
+	for(int h = 0; h < InstanceCount; h++) {
+		I[h]->parent = parentIds[h].empty() ? -1 : findInstance(parentIds[h]);
+		if(!parentIds[h].empty() && ((I[h]->parent < 0) || (I[h]->parent == h))) {
+			std::cout << "Instance " << *I[h]->id << ": unknown parent " << parentIds[h] << "\n";
+			I[h]->parent = -1;
+		}
+		if(I[h]->parent < 0) {
+			roots.push_back(h);
+		} else {
+			children[I[h]->parent].push_back(h);
+		}
+	}
+
+	graphOrder = roots;
+	graphRank.assign(InstanceCount, -1);
+	firstChild.assign(InstanceCount, 0);
+	childCount.assign(InstanceCount, 0);
+	for(int q = 0; q < graphOrder.size(); q++) {
+		int h = graphOrder[q];
+		graphRank[h] = q;
+		firstChild[h] = graphOrder.size();
+		childCount[h] = children[h].size();
+		graphOrder.insert(graphOrder.end(), children[h].begin(), children[h].end());
+	}
+	if(graphOrder.size() < InstanceCount) {
+		// never reached from a root
+		for(int h = 0; h < InstanceCount; h++) {
+			if(graphRank[h] < 0) {
+				std::cout << "Instance " << *I[h]->id << ": its parents form a cycle\n";
+				I[h]->parent = -1;
+				graphRank[h] = graphOrder.size();
+				graphOrder.push_back(h);
+				childCount[h] = 0;
+			}
+		}
+	}
+
+	for(int h : graphOrder) {
+		I[h]->Wm = parentWorld(I[h]) * localMatrix(I[h]);
+		I[h]->localChanged = false;
+	}
+	changedLocals.clear();
+}
+
+void Scene::markDirty(Instance *inst) {
+	inst->dirtyImages = ~0u;
+	inst->NmValid = false;
+}
+
+// All the normal matrices at once, with the batch kernel of the store
+void Scene::markAllDirty() {
+	std::vector<glm::mat4> Nm(store.count);
+	store.computeNormals(Nm.data());
+	for(int i = 0; i < HandleCount; i++) {
+		if(I[i]->TIp == nullptr) {
+			continue;
+		}
+		markDirty(I[i]);
+		I[i]->Nm = Nm[i];
+		I[i]->NmValid = true;
+	}
+}
+
+// True if the uniforms of inst for image currentImage must be written again: the
+// flag of that image is cleared, the other images are written in their own frames
+bool Scene::takeDirty(Instance *inst, int currentImage) {
+	uint32_t bit = 1u << currentImage;
+	bool dirty = (inst->dirtyImages & bit) != 0;
+	inst->dirtyImages &= ~bit;
+	return dirty;
+}
+
+// Inverse transpose of Wm, computed only once after each change
+const glm::mat4 &Scene::normalMatrix(Instance *inst) {
+	if(!inst->NmValid) {
+		inst->Nm = InstanceStore::normalMatrix(inst->Wm);
+		inst->NmValid = true;
+	}
+	return inst->Nm;
+}
+
+// must be called before init(). DS must be initialized by the application
+// before pipelinesAndDescriptorSetsInit()
+void Scene::shareDescriptorSet(DescriptorSetLayout *DSL, DescriptorSet *DS) {
+	SharedDS[DSL] = DS;
+}
+
+// A pass uses the descriptor set j of an earlier pass of the same technique when
+// both have the same layout and the same textures (e.g. a depth pre-pass):
+// returns that pass, or -1 if the set must be allocated
+int Scene::reusedSetPass(TechniqueRef *Tr, int ipas, int j) {
+	DescriptorSetLayout *DSL = Tr->PT[ipas].P->D[j];
+	auto &TD = Tr->PT[ipas].texDefs[j];
+	for(int q = 0; q < ipas; q++) {
+		if((Tr->PT[q].P->D.size() <= j) || (Tr->PT[q].P->D[j] != DSL) ||
+		   (Tr->PT[q].texDefs[j].size() != TD.size())) {
+			continue;
+		}
+		bool same = true;
+		for(int kt = 0; kt < TD.size(); kt++) {
+			auto &A = Tr->PT[q].texDefs[j][kt];
+			same = same && (A.fromInstance == TD[kt].fromInstance) &&
+					(A.fromInstance ? (A.pos == TD[kt].pos) :
+						((A.info.imageView == TD[kt].info.imageView) &&
+						 (A.info.sampler == TD[kt].info.sampler)));
+		}
+		if(same) {
+			return q;
+		}
+	}
+	return -1;
+}
+
 int Scene::init(BaseProject *_BP,  int _Npasses, std::vector<VertexDescriptorRef>  &VDRs,  
 		  std::vector<TechniqueRef> &PRs, std::string file) {
 	BP = _BP;
@@ -227,12 +665,37 @@ int Scene::init(BaseProject *_BP,  int _Npasses, std::vector<VertexDescriptorRef
 std::cout << ts[k]["id"] << "(" << k << ") " << TT << "\n";
 		}
 
+		// MATERIALS
+		nlohmann::json mts = js["materials"];
+		std::cout << "Materials count: " << mts.size() << "\n";
+		for(int k = 0; k < mts.size(); k++) {
+			std::string Pid = mts[k]["technique"].template get<std::string>();
+			if(TechniqueIds.find(Pid) == TechniqueIds.end()) {
+				std::cout << "Material " << mts[k]["id"] << ": unknown technique " << Pid << "\n";
+				exit(0);
+			}
+			std::vector<int> Tid;
+			for(auto &t : mts[k]["textures"]) {
+				Tid.push_back(TextureIds[t]);
+			}
+			glm::vec3 specularColor(1.0f, 0.95f, 0.9f);
+			nlohmann::json SCjson = mts[k]["specularColor"];
+			if(!SCjson.is_null()) {
+				specularColor = glm::vec3(SCjson[0], SCjson[1], SCjson[2]);
+			}
+			if(addMaterial(mts[k]["id"].template get<std::string>(), TechniqueIds[Pid], Tid,
+						   mts[k].value("gamma", 120.0f), specularColor) < 0) {
+				exit(0);
+			}
+		}
+
 		// INSTANCES TextureCount
 		nlohmann::json pis = js["instances"];
 		TechniqueInstanceCount = pis.size();
 std::cout << "Technique Instances count: " << TechniqueInstanceCount << "\n";
 		TI = (TechniqueInstances *)calloc(TechniqueInstanceCount, sizeof(TechniqueInstances));
 		InstanceCount = 0;
+		std::vector<std::string> parentIds;
 
 		for(int k = 0; k < TechniqueInstanceCount; k++) {
 			std::string Pid = pis[k]["technique"].template get<std::string>();
@@ -247,18 +710,42 @@ std::cout << "Technique: " << Pid << "(" << k << "), Instances count: " << TI[k]
 			
 std::cout << k << "." << j << "\t" << is[j]["id"] << ", " << is[j]["model"] << "(" << MeshIds[is[j]["model"]] << "), {";
 				TI[k].I[j].id  = new std::string(is[j]["id"]);
+				TI[k].I[j].name = intern(*TI[k].I[j].id);
 				TI[k].I[j].Mid = MeshIds[is[j]["model"]];
-				int NTextures = is[j]["texture"].size();
-				if(NTextures != TI[k].T->Ntextures) {
-					std::cout << "Wrong number of textures!\n";
-					exit(0);
+				TI[k].I[j].occluder = is[j].value("occluder", false);
+				TI[k].I[j].occludee = is[j].value("occludee", true);
+				TI[k].I[j].isStatic = is[j].value("static", false);
+				int mat;
+				if(is[j].contains("material")) {
+					auto mt = MaterialIds.find(is[j]["material"].template get<std::string>());
+					if((mt == MaterialIds.end()) || (Mat[mt->second]->T != TI[k].T)) {
+						std::cout << "Unknown material " << is[j]["material"] << " for technique " << Pid << "\n";
+						exit(0);
+					}
+					mat = mt->second;
+				} else {
+					// the instances with the same textures share an implicit material
+					std::string Mname = Pid;
+					std::vector<int> Tid;
+					for(auto &t : is[j]["texture"]) {
+						Mname += std::string(Tid.empty() ? ":" : ",") + t.template get<std::string>();
+						Tid.push_back(TextureIds[t]);
+					}
+					auto mt = MaterialIds.find(Mname);
+					mat = (mt != MaterialIds.end()) ? mt->second :
+						  addMaterial(Mname, TI[k].T, Tid, 120.0f, glm::vec3(1.0f, 0.95f, 0.9f));
+					if(mat < 0) {
+						exit(0);
+					}
 				}
+				TI[k].I[j].mat = mat;
+				int NTextures = Mat[mat]->Tid.size();
 				TI[k].I[j].NTx = NTextures;
 				TI[k].I[j].Tid = (int *)calloc(NTextures, sizeof(int));
-std::cout << "#" << NTextures;
+std::cout << *Mat[mat]->id << " #" << NTextures;
 				for(int h = 0; h < NTextures; h++) {
-					TI[k].I[j].Tid[h] = TextureIds[is[j]["texture"][h]];
-std::cout << " " << is[j]["texture"][h] << "(" << TI[k].I[j].Tid[h] << ")";
+					TI[k].I[j].Tid[h] = Mat[mat]->Tid[h];
+std::cout << " " << TI[k].I[j].Tid[h];
 				}
 std::cout << "}\n";
 				nlohmann::json TMjson = is[j]["transform"];
@@ -326,25 +813,15 @@ std::cout << "\n";
 					for(int h = 0; h < 16; h++) {TMj[h] = TMjson[h];}
 					TI[k].I[j].Wm = glm::mat4(TMj[0],TMj[4],TMj[8],TMj[12],TMj[1],TMj[5],TMj[9],TMj[13],TMj[2],TMj[6],TMj[10],TMj[14],TMj[3],TMj[7],TMj[11],TMj[15]);
 				}	
+				// relative to the parent, the world matrix is computed by buildGraph()
+				decompose(TI[k].I[j].Wm, &TI[k].I[j]);
+				parentIds.push_back(is[j].value("parent", std::string{}));
 				TI[k].I[j].TIp = &TI[k];
 				TI[k].I[j].D = (std::vector<DescriptorSetLayout *> **)calloc(sizeof(std::vector<DescriptorSetLayout *> *), Npasses);
 				TI[k].I[j].NDs = (int *)calloc(sizeof(int), Npasses);
 				for(int ipas = 0; ipas < Npasses; ipas++) {
 					TI[k].I[j].D[ipas] = &TI[k].T->PT[ipas].P->D;
 					TI[k].I[j].NDs[ipas] = TI[k].I[j].D[ipas]->size();
-					BP->DPSZs.setsInPool += TI[k].I[j].NDs[ipas];
-					for(int h = 0; h < TI[k].I[j].NDs[ipas]; h++) {
-						DescriptorSetLayout *DSL = (*TI[k].I[j].D[ipas])[h];
-						int DSLsize = DSL->Bindings.size();
-
-						for (int l = 0; l < DSLsize; l++) {
-							if(DSL->Bindings[l].type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) {
-								BP->DPSZs.uniformBlocksInPool += 1;
-							} else {
-								BP->DPSZs.texturesInPool += 1;
-							}
-						}
-					}
 				}
 				InstanceCount++;
 			}
@@ -357,13 +834,30 @@ std::cout << "Creating instances\n";
 		for(int k = 0; k < TechniqueInstanceCount; k++) {
 			for(int j = 0; j < TI[k].InstanceCount; j++) {
 				I[i] = &TI[k].I[j];
-				InstanceIds[*I[i]->id] = i;
-				I[i]->Iid = i;
+				if(NameFirst[I[i]->name] < 0) {
+					NameFirst[I[i]->name] = i;
+				}
+				i++;
+			}
+		}
+		buildGraph(parentIds);
+
+		i = 0;
+		for(int k = 0; k < TechniqueInstanceCount; k++) {
+			for(int j = 0; j < TI[k].InstanceCount; j++) {
+				I[i]->Iid = store.add(I[i]->Wm, M[I[i]->Mid]->getBounds(), I[i]->Mid,
+									  (I[i]->isStatic ? INSTANCE_STATIC : 0) |
+									  (I[i]->occluder ? INSTANCE_OCCLUDER : 0) |
+									  (I[i]->occludee ? INSTANCE_OCCLUDEE : 0));
 				
 				i++;
 			}
 		}
 std::cout << i << " instances created\n";
+		HandleCount = handleCapacity = InstanceCount;
+		spawned.assign(TechniqueInstanceCount, {});
+		hiddenBits.assign((InstanceCount + 63) / 64, 0);
+		selectedBits.assign((InstanceCount + 63) / 64, 0);
 
 
 /*		} catch (const nlohmann::json::exception& e) {
@@ -377,9 +871,54 @@ std::cout << i << " instances created\n";
 	return 0;
 }
 
+// Id must be unique, Tid has the textures of the technique. Returns the position of the
+// material in Mat, or -1. To be called before the pools are created
+int Scene::addMaterial(const std::string &id, TechniqueRef *Tr, const std::vector<int> &Tid,
+					   float gamma, glm::vec3 specularColor) {
+	if(MaterialIds.find(id) != MaterialIds.end()) {
+		std::cout << "Duplicate material " << id << "\n";
+		return -1;
+	}
+	if(Tid.size() != Tr->Ntextures) {
+		std::cout << "Wrong number of textures for material " << id << ": " << Tid.size() << " != " << Tr->Ntextures << "\n";
+		return -1;
+	}
+	Material *m = new Material();
+	m->id = new std::string(id);
+	m->T = Tr;
+	m->Tid = Tid;
+	m->gamma = gamma;
+	m->specularColor = specularColor;
+	Mat.push_back(m);
+	MaterialIds[id] = Mat.size() - 1;
+	return Mat.size() - 1;
+}
 
 void Scene::pipelinesAndDescriptorSetsInit() {
 //std::cout << "Scene DS init\n";
+	auto start = std::chrono::high_resolution_clock::now();
+	setBatch.init(BP);
+	if(bulkDescriptorSets) {
+		// at most a material set per pass of each material, and a local set per pass of each instance
+		setBatch.reserve((Mat.size() + InstanceCount) * Npasses);
+	}
+	descriptorSetsCreated = 0;
+	for(Material *m : Mat) {
+		TechniqueRef *Tr = m->T;
+		int j = Tr->materialSet;
+		m->DS.assign(Npasses, nullptr);
+		for(int ipas = 0; ipas < Npasses; ipas++) {
+			if((j < 0) || (j >= Tr->PT[ipas].P->D.size())) {
+				continue;
+			}
+			int q = reusedSetPass(Tr, ipas, j);
+			if(q >= 0) {
+				m->DS[ipas] = m->DS[q];
+				continue;
+			}
+			m->DS[ipas] = createSet(Tr->PT[ipas].P->D[j], textureInfos(Tr, m->Tid.data(), ipas, j));
+		}
+	}
 	for(int i = 0; i < InstanceCount; i++) {
 //std::cout << "I: " << i << ", NTx: " << I[i]->NTx << ", NDs: " << I[i]->NDs << ", nPasses: " << Npasses << "\n";
 
@@ -388,31 +927,42 @@ void Scene::pipelinesAndDescriptorSetsInit() {
 //std::cout << "DSs for pass " << ipas << ": " << I[i]->NDs[ipas] << "\n";
 			I[i]->DS[ipas] = (DescriptorSet **)calloc(I[i]->NDs[ipas], sizeof(DescriptorSet *));
 			for(int j = 0; j < I[i]->NDs[ipas]; j++) {
-				std::vector<VkDescriptorImageInfo> Tids = {};
+				auto shared = SharedDS.find((*I[i]->D[ipas])[j]);
+				if(shared != SharedDS.end()) {
+					I[i]->DS[ipas][j] = shared->second;
+					continue;
+				}
 				TechniqueRef *Tr = I[i]->TIp->T;
-				int ntxs = Tr->PT[ipas].texDefs[j].size();
-				Tids.resize(ntxs);
-//std::cout << "DSs " << j << " for pass " << ipas << " has " << ntxs << " textures\n";
-				for(int kt = 0; kt < ntxs; kt++) {
-					if(Tr->PT[ipas].texDefs[j][kt].fromInstance) {
-						Tids[kt] = T[I[i]->Tid[
-									  Tr->PT[ipas].texDefs[j][kt].pos
-								    ]]->getViewAndSampler();
-//std::cout << "Getting " << Tids[kt].sampler << " " << Tids[kt].imageView << " " << Tids[kt].imageLayout << " from insance for: i" << i << " p" << ipas << " d" << j << " t" << kt << "\n";
-					} else {
-						Tids[kt] = Tr->PT[ipas].texDefs[j][kt].info;
-//std::cout << "Getting " << Tids[kt].sampler << " " << Tids[kt].imageView << " " << Tids[kt].imageLayout << " from technique for: i" << i << " p" << ipas << " d" << j << " t" << kt << "\n";
-//						Tids[kt] = T[0]->getViewAndSampler();
-					}
+				if(j == Tr->materialSet) {
+					I[i]->DS[ipas][j] = Mat[I[i]->mat]->DS[ipas];
+					continue;
 				}
-
-				I[i]->DS[ipas][j] = new DescriptorSet();
-//std::cout << "Allocating DS for DSL: " << (*I[i]->D[ipas])[j] << ", with " << Tids.size() << " textures\n";
-				I[i]->DS[ipas][j]->init(BP, (*I[i]->D[ipas])[j], Tids);
-//std::cout << "DSs " << j << " for pass " << ipas << " done!\n";
+				int q = reusedSetPass(Tr, ipas, j);
+				if(q >= 0) {
+					I[i]->DS[ipas][j] = I[i]->DS[q][j];
+					continue;
+				}
+				StaticBatch *B = I[i]->batch;
+				if((B != nullptr) && (B->leader != I[i])) {
+					// same material: the sets of the leader, that comes first
+					I[i]->DS[ipas][j] = B->leader->DS[ipas][j];
+					continue;
+				}
+				I[i]->DS[ipas][j] = createSet((*I[i]->D[ipas])[j], textureInfos(Tr, I[i]->Tid, ipas, j));
 			}
 		}
 	}
+	setBatch.create();
+	descriptorSetsMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	std::cout << "Scene descriptor sets: " << descriptorSetsCreated << " in " << descriptorSetsMs << " ms (" <<
+				 (bulkDescriptorSets ? "bulk" : "one by one") << ")\n";
+	for(auto &S : spawned) {
+		for(Instance *inst : S) {
+			allocateSpawnedSets(inst);
+		}
+	}
+	// new uniform buffers: everything is written again
+	markAllDirty();
 std::cout << "Scene DS init Done\n";
 }
 
@@ -421,6 +971,9 @@ void Scene::pipelinesAndDescriptorSetsCleanup() {
 	for(int i = 0; i < InstanceCount; i++) {
 		for(int ipas = 0; ipas < Npasses; ipas++) {
 			for(int j = 0; j < I[i]->NDs[ipas]; j++) {
+				if(!ownsSet(I[i], ipas, j)) {
+					continue;
+				}
 				I[i]->DS[ipas][j]->cleanup();
 				delete I[i]->DS[ipas][j];
 			}
@@ -428,6 +981,307 @@ void Scene::pipelinesAndDescriptorSetsCleanup() {
 		}
 		free(I[i]->DS);
 	}
+	// the pools are made again for the new swap chain, the instances stay
+	for(auto &S : spawned) {
+		for(Instance *inst : S) {
+			releaseSpawnedSets(inst, false);
+		}
+	}
+	destroySpawnPools();
+	for(Material *m : Mat) {
+		for(int ipas = 0; ipas < m->DS.size(); ipas++) {
+			if((m->DS[ipas] != nullptr) && (reusedSetPass(m->T, ipas, m->T->materialSet) < 0)) {
+				m->DS[ipas]->cleanup();
+				delete m->DS[ipas];
+			}
+		}
+		m->DS.clear();
+	}
+	// the uniform buffer of the bulk sets
+	setBatch.cleanup();
+}
+
+// Filled by setBatch.create() in bulk mode
+DescriptorSet *Scene::createSet(DescriptorSetLayout *DSL, const std::vector<VkDescriptorImageInfo> &Tids) {
+	DescriptorSet *DS = new DescriptorSet();
+	if(bulkDescriptorSets) {
+		setBatch.add(DS, DSL, Tids);
+	} else {
+		DS->init(BP, DSL, Tids);
+	}
+	descriptorSetsCreated++;
+	return DS;
+}
+
+// Tid: the textures of an instance or of a material
+std::vector<VkDescriptorImageInfo> Scene::textureInfos(TechniqueRef *Tr, const int *Tid, int ipas, int j) {
+	int ntxs = Tr->PT[ipas].texDefs[j].size();
+	std::vector<VkDescriptorImageInfo> Tids(ntxs);
+	for(int kt = 0; kt < ntxs; kt++) {
+		if(Tr->PT[ipas].texDefs[j][kt].fromInstance) {
+			Tids[kt] = T[Tid[Tr->PT[ipas].texDefs[j][kt].pos]]->getViewAndSampler();
+		} else {
+			Tids[kt] = Tr->PT[ipas].texDefs[j][kt].info;
+		}
+	}
+	return Tids;
+}
+
+// False if set j of pass ipas of inst belongs to someone else (the application, another
+// pass, its material, the leader of its batch)
+bool Scene::ownsSet(Instance *inst, int ipas, int j) {
+	return (SharedDS.find((*inst->D[ipas])[j]) == SharedDS.end()) &&
+		   (reusedSetPass(inst->TIp->T, ipas, j) < 0) &&
+		   (j != inst->TIp->T->materialSet) &&
+		   ((inst->batch == nullptr) || (inst->batch->leader == inst));
+}
+
+// Model Mid with material mat, at the given transform (with no parent), drawn with the
+// first technique instances of its technique. Returns its handle, or -1.
+// To be called after pipelinesAndDescriptorSetsInit(); the command buffers must be
+// recorded again
+int Scene::addInstance(int mat, int Mid, const std::string &id, glm::vec3 pos, glm::quat rot, glm::vec3 scl) {
+	int k = 0;
+	while((k < TechniqueInstanceCount) && (TI[k].T != Mat[mat]->T)) {
+		k++;
+	}
+	if(k == TechniqueInstanceCount) {
+		std::cout << "No instances of technique " << *Mat[mat]->T->id << " for " << id << "\n";
+		return -1;
+	}
+
+	int h;
+	if(!freeHandles.empty()) {
+		h = freeHandles.back();
+		freeHandles.pop_back();
+	} else {
+		h = HandleCount++;
+		if(h >= handleCapacity) {
+			handleCapacity = std::max(2 * handleCapacity, 64);
+			I = (Instance **)realloc(I, handleCapacity * sizeof(Instance *));
+		}
+		I[h] = new Instance();
+		store.add(glm::mat4(1.0f), M[Mid]->getBounds(), Mid, 0);
+		graphRank.push_back(graphOrder.size());
+		graphOrder.push_back(h);
+		firstChild.push_back(0);
+		childCount.push_back(0);
+		if(HandleCount > hiddenBits.size() * 64) {
+			hiddenBits.push_back(0);
+			selectedBits.push_back(0);
+		}
+	}
+
+	Instance *inst = I[h];
+	*inst = Instance();
+	inst->id = new std::string(id);
+	inst->name = intern(id);
+	if(NameFirst[inst->name] < 0) {
+		NameFirst[inst->name] = h;
+	}
+	inst->Mid = Mid;
+	inst->mat = mat;
+	inst->NTx = Mat[mat]->Tid.size();
+	inst->Tid = (int *)calloc(std::max(inst->NTx, 1), sizeof(int));
+	for(int t = 0; t < inst->NTx; t++) {
+		inst->Tid[t] = Mat[mat]->Tid[t];
+	}
+	inst->Iid = h;
+	inst->TIp = &TI[k];
+	inst->D = (std::vector<DescriptorSetLayout *> **)calloc(sizeof(std::vector<DescriptorSetLayout *> *), Npasses);
+	inst->NDs = (int *)calloc(sizeof(int), Npasses);
+	for(int ipas = 0; ipas < Npasses; ipas++) {
+		inst->D[ipas] = &TI[k].T->PT[ipas].P->D;
+		inst->NDs[ipas] = inst->D[ipas]->size();
+	}
+	inst->parent = -1;
+	inst->pos = pos;
+	inst->rot = rot;
+	inst->scl = scl;
+	inst->Wm = localMatrix(inst);
+	inst->spawned = true;
+	inst->spawnPos = spawned[k].size();
+	spawned[k].push_back(inst);
+
+	store.localBounds[h] = M[Mid]->getBounds();
+	store.modelId[h] = Mid;
+	store.flags[h] = 0;
+	store.setWorld(h, inst->Wm);
+
+	allocateSpawnedSets(inst);
+	markDirty(inst);
+	spawnedCount++;
+	drawOrderValid = false;
+	return h;
+}
+
+// Only the instances added with addInstance() can be removed (the others can be hidden).
+// The command buffers must be recorded again
+bool Scene::removeInstance(int h) {
+	if((h < InstanceCount) || (h >= HandleCount) || (I[h]->TIp == nullptr)) {
+		return false;
+	}
+	Instance *inst = I[h];
+	auto &S = spawned[inst->TIp - TI];
+	S[inst->spawnPos] = S.back();
+	S[inst->spawnPos]->spawnPos = inst->spawnPos;
+	S.pop_back();
+
+	releaseSpawnedSets(inst, true);
+	uint64_t bit = 1ull << (h & 63);
+	hiddenBits[h >> 6] &= ~bit;
+	selectedBits[h >> 6] &= ~bit;
+	if(NameFirst[inst->name] == h) {
+		NameFirst[inst->name] = -1;
+	}
+	delete inst->id;
+	free(inst->Tid);
+	free(inst->D);
+	free(inst->NDs);
+	inst->TIp = nullptr;
+	inst->localChanged = false;
+	store.flags[h] = 0;
+
+	freeHandles.push_back(h);
+	spawnedCount--;
+	drawOrderValid = false;
+	return true;
+}
+
+// To be called once per frame: the sets of the instances removed long enough ago
+// (no command buffer in flight can use them) are available again
+void Scene::recycle() {
+	frame++;
+	int delay = BP->swapChainImages.size() + MAX_FRAMES_IN_FLIGHT;
+	int n = 0;
+	while((n < retiredSets.size()) && (frame - retiredSets[n].first >= delay)) {
+		DescriptorSet *DS = retiredSets[n].second;
+		freeSets[DS->Layout].push_back(DS);
+		n++;
+	}
+	retiredSets.erase(retiredSets.begin(), retiredSets.begin() + n);
+}
+
+int Scene::spawnChunkCount() const {
+	return chunks.size();
+}
+
+void Scene::allocateSpawnedSets(Instance *inst) {
+	inst->DS = (DescriptorSet ***)calloc(Npasses, sizeof(DescriptorSet **));
+	for(int ipas = 0; ipas < Npasses; ipas++) {
+		inst->DS[ipas] = (DescriptorSet **)calloc(std::max(inst->NDs[ipas], 1), sizeof(DescriptorSet *));
+		for(int j = 0; j < inst->NDs[ipas]; j++) {
+			DescriptorSetLayout *DSL = (*inst->D[ipas])[j];
+			auto shared = SharedDS.find(DSL);
+			TechniqueRef *Tr = inst->TIp->T;
+			int q = reusedSetPass(Tr, ipas, j);
+			if(shared != SharedDS.end()) {
+				inst->DS[ipas][j] = shared->second;
+			} else if(j == Tr->materialSet) {
+				inst->DS[ipas][j] = Mat[inst->mat]->DS[ipas];
+			} else if(q >= 0) {
+				inst->DS[ipas][j] = inst->DS[q][j];
+			} else {
+				inst->DS[ipas][j] = spawnSet(DSL, textureInfos(Tr, inst->Tid, ipas, j));
+			}
+		}
+	}
+}
+
+// reuse: the sets go to the free lists (after recycle()), otherwise they are deleted
+void Scene::releaseSpawnedSets(Instance *inst, bool reuse) {
+	for(int ipas = 0; ipas < Npasses; ipas++) {
+		for(int j = 0; j < inst->NDs[ipas]; j++) {
+			if(!ownsSet(inst, ipas, j)) {
+				continue;
+			}
+			if(reuse) {
+				retiredSets.push_back({frame, inst->DS[ipas][j]});
+			} else {
+				inst->DS[ipas][j]->cleanup();
+				delete inst->DS[ipas][j];
+			}
+		}
+		free(inst->DS[ipas]);
+	}
+	free(inst->DS);
+	inst->DS = nullptr;
+}
+
+DescriptorSet *Scene::spawnSet(DescriptorSetLayout *DSL, const std::vector<VkDescriptorImageInfo> &Tids) {
+	auto &F = freeSets[DSL];
+	if(!F.empty()) {
+		DescriptorSet *DS = F.back();
+		F.pop_back();
+		DS->updateImages(Tids);
+		spawnSetsReused++;
+		return DS;
+	}
+
+	auto it = openChunk.find(DSL);
+	if((it == openChunk.end()) || (chunks[it->second].used == SPAWN_CHUNK)) {
+		int images = BP->swapChainImages.size();
+		SpawnChunk C = {DSL, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, DescriptorSet::slotSize(BP, DSL), 0};
+
+		std::map<VkDescriptorType, uint32_t> counts;
+		for(auto &B : DSL->Bindings) {
+			counts[B.type] += B.count * SPAWN_CHUNK * images;
+		}
+		std::vector<VkDescriptorPoolSize> poolSizes;
+		for(auto &c : counts) {
+			poolSizes.push_back({c.first, c.second});
+		}
+		VkDescriptorPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+		poolInfo.pPoolSizes = poolSizes.data();
+		poolInfo.maxSets = static_cast<uint32_t>(SPAWN_CHUNK * images);
+		VkResult result = vkCreateDescriptorPool(BP->device, &poolInfo, nullptr, &C.pool);
+		if (result != VK_SUCCESS) {
+			PrintVkError(result);
+			throw std::runtime_error("failed to create descriptor pool!");
+		}
+		if(C.slotSize > 0) {
+			BP->createBuffer(C.slotSize * SPAWN_CHUNK,
+							 VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+							 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+							 C.buffer, C.memory);
+		}
+		chunks.push_back(C);
+		openChunk[DSL] = chunks.size() - 1;
+	}
+
+	SpawnChunk &C = chunks[openChunk[DSL]];
+	UniformSlot slot = {C.buffer, C.memory, C.slotSize * C.used};
+	C.used++;
+	DescriptorSet *DS = new DescriptorSet();
+	DS->init(BP, DSL, Tids, C.pool, (C.slotSize > 0) ? &slot : nullptr);
+	spawnSetsAllocated++;
+	return DS;
+}
+
+void Scene::destroySpawnPools() {
+	for(auto &F : freeSets) {
+		for(DescriptorSet *DS : F.second) {
+			DS->cleanup();
+			delete DS;
+		}
+	}
+	for(auto &R : retiredSets) {
+		R.second->cleanup();
+		delete R.second;
+	}
+	freeSets.clear();
+	retiredSets.clear();
+	for(SpawnChunk &C : chunks) {
+		vkDestroyDescriptorPool(BP->device, C.pool, nullptr);
+		if(C.buffer != VK_NULL_HANDLE) {
+			vkDestroyBuffer(BP->device, C.buffer, nullptr);
+			vkFreeMemory(BP->device, C.memory, nullptr);
+		}
+	}
+	chunks.clear();
+	openChunk.clear();
 }
 
 void Scene::localCleanup() {
@@ -444,12 +1298,45 @@ void Scene::localCleanup() {
 		delete M[i];
 	}
 	free(M);
+
+	for(StaticBatch *B : batches) {
+		B->M->cleanup();
+		delete B->M;
+		delete B;
+	}
+	batches.clear();
 	
 	for(int i = 0; i < InstanceCount; i++) {
 		delete I[i]->id;
 		free(I[i]->Tid);
 	}
+	for(int h = InstanceCount; h < HandleCount; h++) {
+		if(I[h]->TIp != nullptr) {
+			delete I[h]->id;
+			free(I[h]->Tid);
+			free(I[h]->D);
+			free(I[h]->NDs);
+		}
+		delete I[h];
+	}
 	free(I);
+	for(Material *m : Mat) {
+		delete m->id;
+		delete m;
+	}
+	Mat.clear();
+	MaterialIds.clear();
+	drawOrder.clear();
+	drawOrderValid = false;
+	spawned.clear();
+	freeHandles.clear();
+	HandleCount = handleCapacity = spawnedCount = 0;
+	store.clear();
+	Names.clear();
+	NameIds.clear();
+	NameFirst.clear();
+	hiddenBits.clear();
+	selectedBits.clear();
 	
 	// To add: delete the also the datastructure relative to the pipeline
 	for(int i = 0; i < TechniqueInstanceCount; i++) {
@@ -458,32 +1345,202 @@ void Scene::localCleanup() {
 	free(TI);
 }
 
+// The instances of each technique are drawn sorted by material and model: the pipeline
+// is bound once, and a descriptor set, a model or the material push constant only when
+// it differs from the previous draw (e.g. the global and the material sets once per material)
 void Scene::populateCommandBuffer(VkCommandBuffer commandBuffer, int passId, int currentImage) {
 	if(passId >= Npasses) {
 		std::cout << "Scene Error: requested a pass too high in scene : " << passId << " >= " << Npasses << "\n";
 		exit(0);
 	}
+	if(!drawOrderValid) {
+		sortDraws();
+	}
 	
 //std::cout << "Generating draw calls for pass " << passId << "\n";
 	for(int k = 0; k < TechniqueInstanceCount; k++) {
 //std::cout << "Considering technique " << k << "\n";
-		for(int i = 0; i < TI[k].InstanceCount; i++) {
-			Pipeline *P = TI[k].T->PT[passId].P;
-			if(P != nullptr) {
-				P->bind(commandBuffer);
+		Pipeline *P = TI[k].T->PT[passId].P;
+		if(P == nullptr) {
+			continue;
+		}
+		P->bind(commandBuffer);
+		std::vector<DescriptorSet *> bound(P->D.size(), nullptr);
+		Model *boundModel = nullptr;
+		int pushedMat = -1;
 
-//std::cout << "Drawing Instance " << i << "\n";
-				M[TI[k].I[i].Mid]->bind(commandBuffer);
-				for(int j = 0; j < TI[k].I[i].NDs[passId]; j++) {
+		for(Instance *inst : drawOrder[k]) {
+			// the batches are always drawn
+			StaticBatch *B = inst->batch;
+			if((B == nullptr) && (inst->culled || inst->occluded)) {
+				continue;
+			}
+			Model *Mo = (B != nullptr) ? B->M : M[inst->Mid];
+			if(Mo != boundModel) {
+				Mo->bind(commandBuffer);
+				boundModel = Mo;
+			}
+			for(int j = 0; j < inst->NDs[passId]; j++) {
+				DescriptorSet *DS = inst->DS[passId][j];
+				if(DS != bound[j]) {
 //std::cout << "Binding DS: set " << j << "\n";
-					TI[k].I[i].DS[passId][j]->bind(commandBuffer, *P, j, currentImage);
+					DS->bind(commandBuffer, *P, j, currentImage);
+					bound[j] = DS;
 				}
-//std::cout << "Draw Call\n";						
-				vkCmdDrawIndexed(commandBuffer,
-						static_cast<uint32_t>(M[TI[k].I[i].Mid]->indices.size()), 1, 0, 0, 0);
+			}
+			if((TI[k].T->materialPush != 0) && (inst->mat != pushedMat)) {
+				uint32_t m = inst->mat;
+				vkCmdPushConstants(commandBuffer, P->pipelineLayout, TI[k].T->materialPush, 0, sizeof(uint32_t), &m);
+				pushedMat = inst->mat;
+			}
+//std::cout << "Draw Call\n";
+			if(B != nullptr) {
+				vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(B->M->indices.size()), 1, 0, 0, 0);
+			} else {
+				ModelLOD R = M[inst->Mid]->getLOD(inst->lod);
+				vkCmdDrawIndexed(commandBuffer, R.indexCount, 1, R.firstIndex, 0, 0);
 			}
 		}
 	}
 }
 
+// Per technique instances: the loaded and the spawned instances not in a batch, and the
+// leaders of the batches, by material and then by model
+void Scene::sortDraws() {
+	drawOrder.assign(TechniqueInstanceCount, {});
+	for(int k = 0; k < TechniqueInstanceCount; k++) {
+		std::vector<Instance *> &D = drawOrder[k];
+		for(int i = 0; i < TI[k].InstanceCount; i++) {
+			Instance &inst = TI[k].I[i];
+			if((inst.batch == nullptr) || (inst.batch->leader == &inst)) {
+				D.push_back(&inst);
+			}
+		}
+		D.insert(D.end(), spawned[k].begin(), spawned[k].end());
+		std::stable_sort(D.begin(), D.end(), [](Instance *a, Instance *b) {
+			return (a->mat != b->mat) ? (a->mat < b->mat) : (a->Mid < b->Mid);
+		});
+	}
+	drawOrderValid = true;
+}
+
+// Screen radius (in pixels) below which an instance switches to the next level
+static const float LOD_PIXELS[] = {160.0f, 80.0f, 40.0f};
+#define LOD_HYSTERESIS 0.15f
+
+// Chooses the level of every instance from the projected radius of its bounding
+// sphere. pixelScale is (viewport height / 2) / tan(fovy / 2). An instance moves to
+// a coarser level only when it is 15% below the threshold, and back to a finer one
+// when it is 15% above it, so that it does not flicker at the boundary.
+// Returns true if any level changed: the command buffers must be recorded again
+bool Scene::updateLODs(glm::vec3 eye, float pixelScale) {
+	bool changed = false;
+	int drawn = 0, full = 0;
+	auto update = [&](Instance &inst) {
+		Model *Mo = M[inst.Mid];
+		int lod = 0;
+		if(useLODs && (Mo->LODs.size() > 1)) {
+			glm::vec4 b = store.bounds[inst.Iid];
+			glm::vec3 c = glm::vec3(b);
+			float r = b.w;
+			float d = std::max(glm::length(c - eye) - r, 0.001f);
+			float px = r / d * pixelScale;
+
+			int last = std::min((int)Mo->LODs.size(), (int)(sizeof(LOD_PIXELS) / sizeof(float)) + 1) - 1;
+			lod = std::min(inst.lod, last);
+			while((lod < last) && (px < LOD_PIXELS[lod] * (1.0f - LOD_HYSTERESIS))) {
+				lod++;
+			}
+			while((lod > 0) && (px > LOD_PIXELS[lod - 1] * (1.0f + LOD_HYSTERESIS))) {
+				lod--;
+			}
+		}
+		if(lod != inst.lod) {
+			inst.lod = lod;
+			changed = true;
+		}
+		// the batches draw all their instances
+		if((inst.TIp->T->PT[0].P != nullptr) &&
+		   ((!inst.culled && !inst.occluded) || (inst.batch != nullptr))) {
+			drawn += Mo->getLOD(lod).indexCount / 3;
+			full += Mo->getLOD(0).indexCount / 3;
+		}
+	};
+
+	for(int k = 0; k < TechniqueInstanceCount; k++) {
+		for(int i = 0; i < TI[k].InstanceCount; i++) {
+			update(TI[k].I[i]);
+		}
+		for(Instance *inst : spawned[k]) {
+			update(*inst);
+		}
+	}
+	trianglesDrawn = drawn;
+	trianglesFull = full;
+	return changed;
+}
+
+// Merges the instances with "static": true into one model per material,
+// moving positions and normals to world space. The instances keep their own models
+// (e.g. for the shadow maps), and the descriptor sets of all but the leader of each
+// batch are not allocated. To be called after init(), before pipelinesAndDescriptorSetsInit()
+void Scene::buildStaticBatches(pStaticVertexFunc fixVertices, void *params) {
+	auto start = std::chrono::high_resolution_clock::now();
+	int merged = 0;
+	for(int k = 0; k < TechniqueInstanceCount; k++) {
+		VertexDescriptor *VD = TI[k].T->VD;
+		int stride = VD->Bindings[0].stride;
+		std::map<int, StaticBatch *> byMaterial;
+		for(int i = 0; i < TI[k].InstanceCount; i++) {
+			Instance &inst = TI[k].I[i];
+			if(!inst.isStatic || !VD->Position.hasIt) {
+				continue;
+			}
+			StaticBatch *&B = byMaterial[inst.mat];
+			if(B == nullptr) {
+				B = new StaticBatch();
+				B->TIp = &TI[k];
+				B->leader = &inst;
+				B->M = new Model();
+				B->M->Wm = glm::mat4(1.0f);
+				batches.push_back(B);
+			}
+
+			Model *Mo = M[inst.Mid];
+			int n = Mo->vertices.size() / stride;
+			uint32_t base = B->M->vertices.size() / stride;
+			B->M->vertices.insert(B->M->vertices.end(), Mo->vertices.begin(), Mo->vertices.end());
+			unsigned char *V = &B->M->vertices[base * stride];
+			glm::mat3 Nm = glm::inverse(glm::transpose(glm::mat3(inst.Wm)));
+			for(int v = 0; v < n; v++) {
+				glm::vec3 *p = (glm::vec3 *)(V + v * stride + VD->Position.offset);
+				*p = glm::vec3(inst.Wm * glm::vec4(*p, 1.0f));
+				if(VD->Normal.hasIt) {
+					glm::vec3 *nm = (glm::vec3 *)(V + v * stride + VD->Normal.offset);
+					*nm = glm::normalize(Nm * *nm);
+				}
+			}
+			if(fixVertices != nullptr) {
+				fixVertices(&inst, V, n, params);
+			}
+
+			// full detail only: the levels are chosen per instance
+			ModelLOD R = Mo->getLOD(0);
+			for(uint32_t h = R.firstIndex; h < R.firstIndex + R.indexCount; h++) {
+				B->M->indices.push_back(base + Mo->indices[h]);
+			}
+			B->members.push_back(&inst);
+			inst.batch = B;
+			merged++;
+		}
+	}
+	for(StaticBatch *B : batches) {
+		B->M->initMesh(BP, B->TIp->T->VD, false);
+	}
+	drawOrderValid = false;
+	auto end = std::chrono::high_resolution_clock::now();
+	std::cout << "Static batches: " << merged << " instances in " << batches.size() << " draw calls, merged in " <<
+		std::chrono::duration<float, std::chrono::milliseconds::period>(end - start).count() << " ms\n";
+}
+
 #endif
\ No newline at end of file
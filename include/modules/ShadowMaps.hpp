@@ -0,0 +1,281 @@
+// Cached point light shadows: the depth cube map of every (static) light is rendered
+// once, and then again only for the lights whose sphere of influence contains an
+// instance that has moved, appeared or disappeared. In the steady state no shadow
+// pass is drawn at all.
+// The cubes are the layers of a single cube array (Texture::initDepthCubic), one per
+// light, rendered face by face with an AT_DEPTH_ONLY render pass and sampled by the
+// lit fragment shaders with the light index as layer.
+
+#define SHADOW_MAP_SIZE 512
+#define SHADOW_MAX_LIGHTS 8			// the first lights of the scene cast shadows
+#define SHADOW_NEAR 0.05f			// must match the fragment shaders
+
+struct ShadowCaster {
+	glm::vec4 sphere;		// world bounding sphere when the maps were last rendered
+	bool casts;				// e.g. false for the hidden instances
+	bool rendered;			// casts value when the maps were last rendered
+};
+
+struct ShadowMaps {
+	BaseProject *BP;
+	Scene *SC;
+
+	int count = 0;
+	std::vector<glm::vec4> lightPosRadius;
+	std::vector<bool> dirty;
+	int renderedCubes = 0;		// since the start, for statistics
+
+	Texture T;
+	RenderPass RP;
+
+	// one depth only pipeline per vertex format, selected by technique
+	std::unordered_map<VertexDescriptor *, Pipeline *> VDP;
+	std::unordered_map<TechniqueRef *, Pipeline *> TP;
+
+	std::vector<glm::vec4> modelSphere;					// local bounding sphere of every model
+	std::vector<std::vector<ShadowCaster>> casters;		// [technique instances][instance]
+	std::unordered_map<int, ShadowCaster> spawnedCasters;	// by handle, Scene::addInstance()
+
+	void init(BaseProject *bp, Scene *sc, std::vector<glm::vec4> lights);
+	void addTechnique(TechniqueRef *Tr, VertexDescriptor *VDpos);
+	void setCaster(int k, int i, bool casts);
+	void addCaster(int h);
+	void removeCaster(int h);
+	void create();
+	void cleanup();
+	void destroy();
+	int update();
+	VkDescriptorImageInfo getViewAndSampler();
+
+	private:
+	glm::vec4 worldSphere(const Instance &I);
+	bool touches(glm::vec4 s, int l);
+	void refresh(ShadowCaster &c, glm::vec4 s);
+	void draw(VkCommandBuffer commandBuffer, Pipeline *P, const glm::mat4 &VP, const Instance &I);
+	void render(VkCommandBuffer commandBuffer, int l);
+};
+
+#ifdef SHADOWMAPS_IMPLEMENTATION
+
+// lights: position and radius, only the first SHADOW_MAX_LIGHTS get a shadow map.
+// To be called after the scene has been loaded
+void ShadowMaps::init(BaseProject *bp, Scene *sc, std::vector<glm::vec4> lights) {
+	BP = bp;
+	SC = sc;
+	count = std::min((int)lights.size(), SHADOW_MAX_LIGHTS);
+	lightPosRadius.assign(lights.begin(), lights.begin() + count);
+	dirty.assign(count, true);
+
+	// at least one cube, so that the descriptor is always valid
+	T.initDepthCubic(BP, SHADOW_MAP_SIZE, std::max(count, 1));
+
+	RP.init(BP, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE, 6 * std::max(count, 1),
+			RenderPass::getStandardAttchmentsProperties(AT_DEPTH_ONLY, BP),
+			RenderPass::getStandardDependencies(ATDEP_DEPTH_TRANS));
+	RP.attachments[0].views = T.layerViews;
+
+	modelSphere.resize(SC->ModelCount, glm::vec4(0.0f));
+	casters.resize(SC->TechniqueInstanceCount);
+	for(int k = 0; k < SC->TechniqueInstanceCount; k++) {
+		VertexDescriptor *VD = SC->TI[k].T->VD;
+		int stride = VD->Bindings[0].stride;
+		casters[k].resize(SC->TI[k].InstanceCount);
+		for(int i = 0; i < SC->TI[k].InstanceCount; i++) {
+			int m = SC->TI[k].I[i].Mid;
+			Model *M = SC->M[m];
+			if((modelSphere[m].w == 0.0f) && VD->Position.hasIt && !M->vertices.empty()) {
+				glm::vec3 bmin(1e30f), bmax(-1e30f);
+				for(int v = 0; v < M->vertices.size() / stride; v++) {
+					glm::vec3 p = *(glm::vec3 *)(&M->vertices[v * stride + VD->Position.offset]);
+					bmin = glm::min(bmin, p);
+					bmax = glm::max(bmax, p);
+				}
+				modelSphere[m] = glm::vec4((bmin + bmax) * 0.5f, glm::length(bmax - bmin) * 0.5f);
+			}
+			casters[k][i] = {worldSphere(SC->TI[k].I[i]), true, true};
+		}
+	}
+}
+
+// The instances of technique Tr cast shadows, drawn with a position only vertex format
+// (VDpos) that reads the vertex buffers of its models
+void ShadowMaps::addTechnique(TechniqueRef *Tr, VertexDescriptor *VDpos) {
+	if(VDP.find(VDpos) == VDP.end()) {
+		Pipeline *P = new Pipeline();
+		P->init(BP, VDpos, "shaders/ShadowDepth.vert.spv", "shaders/MeshDepth.frag.spv", {},
+				{{VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4)}});
+		P->setCullMode(VK_CULL_MODE_NONE);
+		P->setColorWrite(false);
+		P->setDepthBias(1.25f, 1.75f);
+		VDP[VDpos] = P;
+	}
+	TP[Tr] = VDP[VDpos];
+}
+
+void ShadowMaps::setCaster(int k, int i, bool casts) {
+	casters[k][i].casts = casts;
+}
+
+// The instance added to the scene with handle h casts shadows: the lights it touches
+// are rendered again at the next update()
+void ShadowMaps::addCaster(int h) {
+	spawnedCasters[h] = {glm::vec4(0.0f), true, false};
+}
+
+// To be called when the instance with handle h is removed from the scene
+void ShadowMaps::removeCaster(int h) {
+	auto it = spawnedCasters.find(h);
+	if(it == spawnedCasters.end()) {
+		return;
+	}
+	if(it->second.rendered) {
+		for(int l = 0; l < count; l++) {
+			if(touches(it->second.sphere, l)) {
+				dirty[l] = true;
+			}
+		}
+	}
+	spawnedCasters.erase(it);
+}
+
+// To be called in pipelinesAndDescriptorSetsInit(): the maps survive a swap chain
+// recreation, they are not rendered again
+void ShadowMaps::create() {
+	RP.create();
+	for(auto &p : VDP) {
+		p.second->create(&RP);
+	}
+}
+
+void ShadowMaps::cleanup() {
+	for(auto &p : VDP) {
+		p.second->cleanup();
+	}
+	RP.cleanup();
+}
+
+void ShadowMaps::destroy() {
+	for(auto &p : VDP) {
+		p.second->destroy();
+		delete p.second;
+	}
+	VDP.clear();
+	TP.clear();
+	RP.destroy();
+	T.cleanup();
+}
+
+VkDescriptorImageInfo ShadowMaps::getViewAndSampler() {
+	return T.getViewAndSampler();
+}
+
+glm::vec4 ShadowMaps::worldSphere(const Instance &I) {
+	const glm::mat4 &Wm = I.Wm;
+	glm::vec4 s = modelSphere[I.Mid];
+	float scale = std::max(glm::length(glm::vec3(Wm[0])),
+				  std::max(glm::length(glm::vec3(Wm[1])), glm::length(glm::vec3(Wm[2]))));
+	return glm::vec4(glm::vec3(Wm * glm::vec4(glm::vec3(s), 1.0f)), s.w * scale);
+}
+
+bool ShadowMaps::touches(glm::vec4 s, int l) {
+	float r = s.w + lightPosRadius[l].w;
+	glm::vec3 d = glm::vec3(s) - glm::vec3(lightPosRadius[l]);
+	return glm::dot(d, d) < r * r;
+}
+
+// To be called every frame, outside of any render pass: finds the lights affected by
+// the instances changed since the last call and renders their cubes again.
+// Returns the number of cubes rendered
+int ShadowMaps::update() {
+	for(int k = 0; k < casters.size(); k++) {
+		for(int i = 0; i < casters[k].size(); i++) {
+			refresh(casters[k][i], worldSphere(SC->TI[k].I[i]));
+		}
+	}
+	for(auto &c : spawnedCasters) {
+		refresh(c.second, worldSphere(*SC->I[c.first]));
+	}
+
+	int n = 0;
+	VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+	for(int l = 0; l < count; l++) {
+		if(dirty[l]) {
+			if(n == 0) {
+				commandBuffer = BP->beginSingleTimeCommands();
+			}
+			render(commandBuffer, l);
+			dirty[l] = false;
+			n++;
+		}
+	}
+	if(n > 0) {
+		// waits for the queue: the frames in flight sample the maps
+		BP->endSingleTimeCommands(commandBuffer);
+		renderedCubes += n;
+	}
+	return n;
+}
+
+// Marks the lights touched by caster c, both where it was and where it is now (s)
+void ShadowMaps::refresh(ShadowCaster &c, glm::vec4 s) {
+	if((s == c.sphere) && (c.casts == c.rendered)) {
+		return;
+	}
+	for(int l = 0; l < count; l++) {
+		if((c.rendered && touches(c.sphere, l)) || (c.casts && touches(s, l))) {
+			dirty[l] = true;
+		}
+	}
+	c.sphere = s;
+	c.rendered = c.casts;
+}
+
+void ShadowMaps::draw(VkCommandBuffer commandBuffer, Pipeline *P, const glm::mat4 &VP, const Instance &I) {
+	glm::mat4 MVP = VP * I.Wm;
+	vkCmdPushConstants(commandBuffer, P->pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT,
+					   0, sizeof(glm::mat4), &MVP);
+	Model *M = SC->M[I.Mid];
+	M->bind(commandBuffer);
+	// always full detail: the maps are not rendered again when the camera moves
+	ModelLOD R = M->getLOD(0);
+	vkCmdDrawIndexed(commandBuffer, R.indexCount, 1, R.firstIndex, 0, 0);
+}
+
+void ShadowMaps::render(VkCommandBuffer commandBuffer, int l) {
+	// cube faces +X, -X, +Y, -Y, +Z, -Z
+	static const glm::vec3 dir[6] = {{1,0,0}, {-1,0,0}, {0,1,0}, {0,-1,0}, {0,0,1}, {0,0,-1}};
+	static const glm::vec3 up[6]  = {{0,-1,0}, {0,-1,0}, {0,0,1}, {0,0,-1}, {0,-1,0}, {0,-1,0}};
+
+	glm::vec3 pos = glm::vec3(lightPosRadius[l]);
+	float far = lightPosRadius[l].w;
+	glm::mat4 Prj = glm::perspective(glm::radians(90.0f), 1.0f, SHADOW_NEAR, far);
+
+	for(int f = 0; f < 6; f++) {
+		glm::mat4 VP = Prj * glm::lookAt(pos, pos + dir[f], up[f]);
+		RP.begin(commandBuffer, 6 * l + f);
+		for(int k = 0; k < SC->TechniqueInstanceCount; k++) {
+			auto it = TP.find(SC->TI[k].T);
+			if(it == TP.end()) {
+				continue;
+			}
+			Pipeline *P = it->second;
+			P->bind(commandBuffer);
+			for(int i = 0; i < SC->TI[k].InstanceCount; i++) {
+				if(!casters[k][i].casts || !touches(casters[k][i].sphere, l)) {
+					continue;
+				}
+				draw(commandBuffer, P, VP, SC->TI[k].I[i]);
+			}
+			for(Instance *inst : SC->spawned[k]) {
+				auto c = spawnedCasters.find(inst->Iid);
+				if((c == spawnedCasters.end()) || !c->second.casts || !touches(c->second.sphere, l)) {
+					continue;
+				}
+				draw(commandBuffer, P, VP, *inst);
+			}
+		}
+		RP.end(commandBuffer);
+	}
+}
+
+#endif
@@ -16,6 +16,12 @@
 #include <chrono>
 #include <unordered_map>
 #include <map>
+#include <string_view>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <filesystem>
 
 #ifdef STARTER_IMPLEMENTATION
 // to allow splitting header and implementation
@@ -157,6 +163,13 @@ enum ModelType {OBJ, GLTF, MGCG};
 
 class AssetFile;
 
+// range of the index buffer of a Model drawing one of its levels of detail
+struct ModelLOD {
+	uint32_t firstIndex;
+	uint32_t indexCount;
+	float error;			// max geometric error, in model units (0 = full detail)
+};
+
 class Model {
 	BaseProject *BP;
 	
@@ -170,6 +183,12 @@ class Model {
 	glm::mat4 Wm;
 	std::vector<unsigned char> vertices{};
 	std::vector<uint32_t> indices{};
+	// levels of detail (see MeshSimplifier.hpp), all sharing the vertex buffer: empty if
+	// not generated, LODs[0] is the full detail. bounds is the local bounding sphere
+	std::vector<ModelLOD> LODs;
+	glm::vec4 bounds = glm::vec4(0.0f);
+	ModelLOD getLOD(int lod);
+	glm::vec4 getBounds();
 	void loadModelOBJ(std::string file);
 	void makeOBJMesh(const tinyobj::shape_t *M, const tinyobj::attrib_t *A);
 	static void getGLTFnodeTransforms(const tinygltf::Node *N, glm::vec3 &T, glm::vec3 &S, glm::quat &Q);
@@ -216,9 +235,11 @@ struct Texture {
 	VkImage textureImage;
 	VkDeviceMemory textureImageMemory;
 	VkImageView textureImageView;
-	VkSampler textureSampler;
+	VkSampler textureSampler = VK_NULL_HANDLE;
 	int imgs;
 	static const int maxImgs = 6;
+	VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	std::vector<VkImageView> layerViews;	// single layers, to render into them
 	
 	void createTextureImage(std::vector<std::string>files, VkFormat Fmt = VK_FORMAT_R8G8B8A8_SRGB);
 	void createTextureImageView(VkFormat Fmt = VK_FORMAT_R8G8B8A8_SRGB);
@@ -231,9 +252,19 @@ struct Texture {
 							 float maxAnisotropy = 16,
 							 float maxLod = -1
 							);
+	static VkSamplerCreateInfo samplerCreateInfo(VkFilter magFilter = VK_FILTER_LINEAR,
+							 VkFilter minFilter = VK_FILTER_LINEAR,
+							 VkSamplerAddressMode addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+							 VkSamplerAddressMode addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+							 VkSamplerMipmapMode mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR,
+							 VkBool32 anisotropyEnable = VK_TRUE,
+							 float maxAnisotropy = 16,
+							 float maxLod = -1
+							);
 
 	void init(BaseProject *bp, std::string file, VkFormat Fmt = VK_FORMAT_R8G8B8A8_SRGB, bool initSampler = true);
 	void initCubic(BaseProject *bp, std::vector<std::string>, VkFormat Fmt = VK_FORMAT_R8G8B8A8_SRGB);
+	void initDepthCubic(BaseProject *bp, int size, int cubes, VkFormat Fmt = VK_FORMAT_D32_SFLOAT);
 	VkDescriptorImageInfo getViewAndSampler();
 	void cleanup();
 };
@@ -244,6 +275,10 @@ struct DescriptorSetLayoutBinding {
 	VkShaderStageFlags flags;
 	int linkSize;
 	int count;
+	// if set, baked into the layout for all the count descriptors (see BaseProject::getSampler):
+	// VK_DESCRIPTOR_TYPE_SAMPLER bindings are then never written, the combined image samplers
+	// only for the views
+	VkSampler immutableSampler = VK_NULL_HANDLE;
 };
 
 
@@ -295,6 +330,10 @@ struct FrameBufferAttachment {
 	VkSampler sampler;
 	bool freeSampler;
 	
+	// if set, one view per framebuffer of an image owned by someone else (e.g. the faces
+	// of a cube map), used instead of creating the attachment image
+	std::vector<VkImageView> views;
+	
   	void init(RenderPass *rp, AttachmentProperties *p, bool initSampler);
 	void cleanup();
 	void destroy();
@@ -354,6 +393,14 @@ struct RenderPass {
 	void createFramebuffers();
 };
 
+// Value of a specialization constant (constant_id) of a shader stage: ints, bools
+// (VK_TRUE / VK_FALSE) and floats are all 32 bits
+struct SpecializationValue {
+	VkShaderStageFlagBits stage;
+	uint32_t id;
+	uint32_t value;
+};
+
 struct Pipeline {
 	BaseProject *BP;
 	VkPipeline graphicsPipeline;
@@ -369,6 +416,16 @@ struct Pipeline {
  	VkCullModeFlagBits CM;
  	bool transp;
 	VkPrimitiveTopology topology;
+	bool depthWrite;
+	bool colorWrite;
+	bool halfPrecision = false;
+	float depthBiasConstant, depthBiasSlope;
+
+	std::vector<SpecializationValue> SV;
+	// variants with other specialization constants: same shaders and state,
+	// created, cleaned up and destroyed together with this pipeline
+	std::map<std::vector<uint32_t>, Pipeline *> variants;
+	Pipeline *base = nullptr;
 	
 	VertexDescriptor *VD;
   	
@@ -384,35 +441,124 @@ struct Pipeline {
 	void setCullMode(VkCullModeFlagBits _CM);
 	void setTransparency(bool _transp);
 	void setTopology(VkPrimitiveTopology _topology);
+	void setDepthWrite(bool _depthWrite);
+	void setColorWrite(bool _colorWrite);
+	void setDepthBias(float constant, float slope);
+	bool setHalfPrecisionShader(const std::string& FragShader16);
+	void setSpecialization(VkShaderStageFlagBits stage, uint32_t id, uint32_t value);
+	void setSpecialization(VkShaderStageFlagBits stage, uint32_t id, float value);
+	Pipeline *variant(std::vector<SpecializationValue> values);
   	
   	VkShaderModule createShaderModule(const std::vector<char>& code);
 	void cleanup();
 };
 
+// Part of a larger buffer: the uniform (and storage) blocks of a descriptor set, for all
+// the swap chain images, one after the other (see DescriptorSet::slotSize())
+struct UniformSlot {
+	VkBuffer buffer;
+	VkDeviceMemory memory;
+	VkDeviceSize offset;
+};
+
+// Descriptor sets from a list of pools made when needed: when the current pool has no
+// room left (or reports VK_ERROR_OUT_OF_POOL_MEMORY) the next one is used, so the sets
+// and their descriptors do not have to be counted in advance. reset() gives back all
+// the sets at once and keeps the pools, e.g. every frame for sets used by one frame
+struct DescriptorAllocator {
+	BaseProject *BP;
+	uint32_t setsPerPool;
+
+	// in use since the last reset()
+	int sets = 0;
+	std::map<VkDescriptorType, int> descriptors;
+
+	void init(BaseProject *bp, uint32_t _setsPerPool = 256);
+	void allocate(const std::vector<DescriptorSetLayout *> &L, VkDescriptorSet *out);
+	VkDescriptorSet allocate(DescriptorSetLayout *L);
+	void reset();
+	void cleanup();
+	int poolCount() const;
+	void printStats(const std::string &name) const;
+
+	private:
+	struct Pool {
+		VkDescriptorPool pool;
+		uint32_t sets, setsLeft;
+		std::map<VkDescriptorType, uint32_t> size, left;
+	};
+	std::vector<Pool> pools;
+	int current = -1;
+
+	static bool fits(const Pool &P, uint32_t n, const std::map<VkDescriptorType, uint32_t> &need);
+	void nextPool(uint32_t n, const std::map<VkDescriptorType, uint32_t> &need);
+};
+
 struct DescriptorSet {
 	BaseProject *BP;
 
 	std::vector<std::vector<VkBuffer>> uniformBuffers;
 	std::vector<std::vector<VkDeviceMemory>> uniformBuffersMemory;
+	std::vector<std::vector<VkDeviceSize>> offsets;		// in the buffers, 0 unless in a UniformSlot
 	std::vector<VkDescriptorSet> descriptorSets;
 	DescriptorSetLayout *Layout;
 	
 	std::vector<bool> toFree;
 
 	void init(BaseProject *bp, DescriptorSetLayout *L,
-						 std::vector<VkDescriptorImageInfo>VaSs);
+						 std::vector<VkDescriptorImageInfo>VaSs,
+						 VkDescriptorPool pool = VK_NULL_HANDLE, const UniformSlot *slot = nullptr);
+	void updateImages(std::vector<VkDescriptorImageInfo>VaSs);
+	static VkDeviceSize slotSize(BaseProject *bp, DescriptorSetLayout *L);
+	static int imageCount(DescriptorSetLayout *L);
 	void cleanup();
   	void bind(VkCommandBuffer commandBuffer, Pipeline &P, int setId, int currentImage);
   	void map(int currentImage, void *src, int slot);
+  	void map(int currentImage, void *src, int slot, int size);
+
+	// the steps of init(), also used by DescriptorSetBatch
+	void initBuffers(BaseProject *bp, DescriptorSetLayout *L, const UniformSlot *slot);
+	void appendWrites(int i, const VkDescriptorImageInfo *VaSs,
+					  std::vector<VkWriteDescriptorSet> &W,
+					  std::vector<VkDescriptorBufferInfo> &BI,
+					  std::vector<VkDescriptorImageInfo> &II);
 };
 
+// Many descriptor sets created at once: their uniform blocks are placed in a single
+// buffer, all of them are allocated with one vkAllocateDescriptorSets and written with
+// one vkUpdateDescriptorSets, instead of a buffer per block and image, an allocation
+// and an update per set
+struct DescriptorSetBatch {
+	BaseProject *BP;
+	UniformSlot slot = {VK_NULL_HANDLE, VK_NULL_HANDLE, 0};
+	std::vector<DescriptorSet *> sets;
+	std::vector<VkDescriptorImageInfo> images;	// of all the sets, one after the other
+	std::vector<int> imageStart;				// [set]: its first entry in images
+
+	void init(BaseProject *bp);
+	void reserve(int setCount);
+	void add(DescriptorSet *DS, DescriptorSetLayout *L, const std::vector<VkDescriptorImageInfo> &VaSs);
+	void create(DescriptorAllocator *A = nullptr);
+	void cleanup();
+};
+
+
+// GPU time spent by the command buffer of each swap chain image, between begin() and end()
+struct GPUTimer {
+	BaseProject *BP;
+	VkQueryPool queryPool = VK_NULL_HANDLE;
+	double timestampPeriod;
+	uint64_t timestampMask;		// the valid bits of the graphics queue
+	int imageCount;
 
-struct PoolSizes {
-	int uniformBlocksInPool = 0;
-	int texturesInPool = 0;
-	int setsInPool = 0;
+	void init(BaseProject *bp);
+	void begin(VkCommandBuffer commandBuffer, int currentImage);
+	void end(VkCommandBuffer commandBuffer, int currentImage);
+	bool read(int currentImage, double &ms);
+	void cleanup();
 };
 
+
 typedef void (* pNCBfunc)(VkCommandBuffer commandBuffer, int i, void *params);
 typedef void (* pNCBfree)(void *params);
 
@@ -445,12 +591,22 @@ class BaseProject {
 	friend class Pipeline;
 	friend class DescriptorSetLayout;
 	friend class DescriptorSet;
+	friend class GPUTimer;
+	friend class ShadowMaps;
+	friend class Scene;
 
 public:
 	virtual void setWindowParameters() = 0;
     void run(); 
 
-	PoolSizes DPSZs;
+	// the descriptor sets of the application, given back at every swap chain recreation
+	DescriptorAllocator descriptors;
+
+	// Samplers shared by all the textures and attachments with the same parameters: each
+	// getSampler() must be matched by a releaseSampler(), the last one destroys it
+	VkSampler getSampler(const VkSamplerCreateInfo &info);
+	void releaseSampler(VkSampler sampler);
+	int samplerCount() const;
 
 protected:
 	uint32_t windowWidth;
@@ -461,6 +617,7 @@ protected:
 
     GLFWwindow* window;
     VkInstance instance;
+	uint32_t instanceApiVersion = VK_API_VERSION_1_0;
 
 	VkSurfaceKHR surface;
     VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
@@ -473,13 +630,24 @@ protected:
 	
 	VkSampleCountFlagBits msaaSamples = VK_SAMPLE_COUNT_1_BIT;
 	
+	// set by createLogicalDevice() when 16 bit float arithmetic can be used in shaders
+	bool shaderFloat16 = false;
+	// and when the shaders can index runtime sized arrays of textures (bindless textures)
+	bool descriptorIndexing = false;
+	
     VkSwapchainKHR swapChain;
     std::vector<VkImage> swapChainImages;
 	VkFormat swapChainImageFormat;
 	VkExtent2D swapChainExtent;
 	std::vector<VkImageView> swapChainImageViews;
-		
- 	VkDescriptorPool descriptorPool;
+
+	struct CachedSampler {
+		VkSamplerCreateInfo info;
+		VkSampler sampler;
+		int refs;
+	};
+	std::vector<CachedSampler> samplers;
+	int samplerRefs = 0;
 
 	VkDebugUtilsMessengerEXT debugMessenger;
 
@@ -522,6 +690,7 @@ protected:
 			bool swapChainPresentModeSupport;
 			bool completeQueueFamily;
 			bool anisotropySupport;
+			bool cubeArraySupport;
 			bool extensionsSupported;
 			std::set<std::string> requiredExtensions;
 			void print();
@@ -543,7 +712,8 @@ protected:
 	void createImageViews();
 	VkImageView createImageView(VkImage image, VkFormat format,
 							VkImageAspectFlags aspectFlags,
-							uint32_t mipLevels, VkImageViewType type, int layerCount
+							uint32_t mipLevels, VkImageViewType type, int layerCount,
+							int baseLayer = 0
 							);
 	void createCommandPool();
 	VkFormat findDepthFormat();
@@ -573,7 +743,6 @@ protected:
 				  VkBuffer& buffer, VkDeviceMemory& bufferMemory);
 	uint32_t findMemoryType(uint32_t typeFilter,
 						VkMemoryPropertyFlags properties);
-	void createDescriptorPool();
 						
 	public:
 	void submitCommandBuffer(std::string name, int order, pNCBfunc populateNewCommandBuffer, void *params, pNCBfree onErase = nullptr);
@@ -806,10 +975,12 @@ void BaseProject::initVulkan() {
 	createImageViews();				
 
 	createCommandPool();			
+	descriptors.init(this);
 	localInit();
 
-	createDescriptorPool();			
 	pipelinesAndDescriptorSetsInit();
+	descriptors.printStats("Descriptor sets");
+	std::cout << "Samplers: " << samplers.size() << ", shared by " << samplerRefs << " textures, attachments and layouts\n";
 
 //		createCommandBuffers();			
 	createSyncObjects();			 
@@ -823,7 +994,15 @@ std::cout << "Starting createInstance()\n"  << std::flush;
 	appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
 	appInfo.pEngineName = "No Engine";
 	appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-	appInfo.apiVersion = VK_API_VERSION_1_0;
+	// Vulkan 1.1 is needed to query the optional device features (e.g. shaderFloat16)
+	auto pfnEnumerateInstanceVersion = (PFN_vkEnumerateInstanceVersion)
+			vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceVersion");
+	uint32_t loaderVersion = VK_API_VERSION_1_0;
+	if(pfnEnumerateInstanceVersion != nullptr) {
+		pfnEnumerateInstanceVersion(&loaderVersion);
+	}
+	instanceApiVersion = (loaderVersion >= VK_API_VERSION_1_1) ? VK_API_VERSION_1_1 : VK_API_VERSION_1_0;
+	appInfo.apiVersion = instanceApiVersion;
 	
 	VkInstanceCreateInfo createInfo{};
 	createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -1000,6 +1179,7 @@ void BaseProject::deviceReport::print() {
 	std::cout << "swapChainPresentModeSupport: " << swapChainPresentModeSupport <<"\n";
 	std::cout << "completeQueueFamily: " << completeQueueFamily <<"\n";
 	std::cout << "anisotropySupport: " << anisotropySupport <<"\n";
+	std::cout << "cubeArraySupport: " << cubeArraySupport <<"\n";
 	std::cout << "extensionsSupported: " << extensionsSupported <<"\n";
 	
 	for (const auto& ext : requiredExtensions) {
@@ -1062,9 +1242,10 @@ bool BaseProject::isDeviceSuitable(VkPhysicalDevice device, deviceReport &devRep
 	
 	devRep.completeQueueFamily = indices.isComplete();
 	devRep.anisotropySupport = supportedFeatures.samplerAnisotropy;
+	devRep.cubeArraySupport = supportedFeatures.imageCubeArray;
 	
 	return devRep.completeQueueFamily && devRep.extensionsSupported && devRep.swapChainAdequate &&
-					devRep.anisotropySupport;
+					devRep.anisotropySupport && devRep.cubeArraySupport;
 }
 
 QueueFamilyIndices BaseProject::findQueueFamilies(VkPhysicalDevice device) {
@@ -1187,9 +1368,64 @@ void BaseProject::createLogicalDevice() {
 	deviceFeatures.samplerAnisotropy = VK_TRUE;
 	deviceFeatures.sampleRateShading = VK_TRUE;
 	deviceFeatures.fillModeNonSolid  = VK_TRUE;
+	deviceFeatures.imageCubeArray    = VK_TRUE;
 	
 	VkDeviceCreateInfo createInfo{};
 	createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+
+	// optional half precision arithmetic, used by Pipeline::setHalfPrecisionShader()
+	VkPhysicalDeviceShaderFloat16Int8FeaturesKHR float16Features{};
+	float16Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_FLOAT16_INT8_FEATURES_KHR;
+	// optional runtime sized texture arrays, indexed with dynamically uniform values
+	VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures{};
+	indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+	VkPhysicalDeviceProperties deviceProperties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
+	auto pfnGetPhysicalDeviceFeatures2 = (PFN_vkGetPhysicalDeviceFeatures2)
+			vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2");
+	shaderFloat16 = false;
+	descriptorIndexing = false;
+	if((instanceApiVersion >= VK_API_VERSION_1_1) &&
+	   (deviceProperties.apiVersion >= VK_API_VERSION_1_1) &&
+	   (pfnGetPhysicalDeviceFeatures2 != nullptr)) {
+		// only the structures of the extensions that the device has are queried
+		bool hasFloat16 = checkIfItHasDeviceExtension(physicalDevice, VK_KHR_SHADER_FLOAT16_INT8_EXTENSION_NAME);
+		bool hasIndexing = checkIfItHasDeviceExtension(physicalDevice, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+		VkPhysicalDeviceFeatures2 features2{};
+		features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		if(hasFloat16) {
+			float16Features.pNext = features2.pNext;
+			features2.pNext = &float16Features;
+		}
+		if(hasIndexing) {
+			indexingFeatures.pNext = features2.pNext;
+			features2.pNext = &indexingFeatures;
+		}
+		pfnGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+
+		void *enabled = nullptr;
+		if(hasFloat16 && float16Features.shaderFloat16) {
+			shaderFloat16 = true;
+			float16Features.shaderInt8 = VK_FALSE;
+			float16Features.pNext = enabled;
+			enabled = &float16Features;
+			deviceExtensions.push_back(VK_KHR_SHADER_FLOAT16_INT8_EXTENSION_NAME);
+		}
+		if(hasIndexing && indexingFeatures.runtimeDescriptorArray &&
+		   features2.features.shaderSampledImageArrayDynamicIndexing) {
+			descriptorIndexing = true;
+			indexingFeatures = {};
+			indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+			indexingFeatures.runtimeDescriptorArray = VK_TRUE;
+			indexingFeatures.pNext = enabled;
+			enabled = &indexingFeatures;
+			deviceFeatures.shaderSampledImageArrayDynamicIndexing = VK_TRUE;
+			deviceExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+		}
+		createInfo.pNext = enabled;
+	}
+	std::cout << "Half precision shaders: " << (shaderFloat16 ? "supported" : "not supported") << "\n";
+	std::cout << "Bindless textures: " << (descriptorIndexing ? "supported" : "not supported") << "\n";
 	
 	createInfo.pQueueCreateInfos = queueCreateInfos.data();
 	createInfo.queueCreateInfoCount = 
@@ -1328,7 +1564,8 @@ void BaseProject::createImageViews() {
 
 VkImageView BaseProject::createImageView(VkImage image, VkFormat format,
 							VkImageAspectFlags aspectFlags,
-							uint32_t mipLevels, VkImageViewType type, int layerCount
+							uint32_t mipLevels, VkImageViewType type, int layerCount,
+							int baseLayer
 							) {
 	VkImageViewCreateInfo viewInfo{};
 	viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -1338,7 +1575,7 @@ VkImageView BaseProject::createImageView(VkImage image, VkFormat format,
 	viewInfo.subresourceRange.aspectMask = aspectFlags;
 	viewInfo.subresourceRange.baseMipLevel = 0;
 	viewInfo.subresourceRange.levelCount = mipLevels;
-	viewInfo.subresourceRange.baseArrayLayer = 0;
+	viewInfo.subresourceRange.baseArrayLayer = baseLayer;
 	viewInfo.subresourceRange.layerCount = layerCount;
 	VkImageView imageView;
 
@@ -1699,25 +1936,54 @@ uint32_t BaseProject::findMemoryType(uint32_t typeFilter,
 	throw std::runtime_error("failed to find suitable memory type!");
 }
 
-void BaseProject::createDescriptorPool() {
-	std::array<VkDescriptorPoolSize, 2> poolSizes{};
-	poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-	poolSizes[0].descriptorCount = static_cast<uint32_t>(DPSZs.uniformBlocksInPool * swapChainImages.size());
-	poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-	poolSizes[1].descriptorCount = static_cast<uint32_t>(DPSZs.texturesInPool * swapChainImages.size());
-														 
-	VkDescriptorPoolCreateInfo poolInfo{};
-	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-	poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());;
-	poolInfo.pPoolSizes = poolSizes.data();
-	poolInfo.maxSets = static_cast<uint32_t>(DPSZs.setsInPool * swapChainImages.size());
-	
-	VkResult result = vkCreateDescriptorPool(device, &poolInfo, nullptr,
-								&descriptorPool);
+static bool sameSampler(const VkSamplerCreateInfo &a, const VkSamplerCreateInfo &b) {
+	return (a.pNext == b.pNext) && (a.flags == b.flags) &&
+		   (a.magFilter == b.magFilter) && (a.minFilter == b.minFilter) && (a.mipmapMode == b.mipmapMode) &&
+		   (a.addressModeU == b.addressModeU) && (a.addressModeV == b.addressModeV) &&
+		   (a.addressModeW == b.addressModeW) && (a.mipLodBias == b.mipLodBias) &&
+		   (a.anisotropyEnable == b.anisotropyEnable) && (a.maxAnisotropy == b.maxAnisotropy) &&
+		   (a.compareEnable == b.compareEnable) && (a.compareOp == b.compareOp) &&
+		   (a.minLod == b.minLod) && (a.maxLod == b.maxLod) && (a.borderColor == b.borderColor) &&
+		   (a.unnormalizedCoordinates == b.unnormalizedCoordinates);
+}
+
+VkSampler BaseProject::getSampler(const VkSamplerCreateInfo &info) {
+	samplerRefs++;
+	for(auto &S : samplers) {
+		if(sameSampler(S.info, info)) {
+			S.refs++;
+			return S.sampler;
+		}
+	}
+	VkSampler sampler;
+	VkResult result = vkCreateSampler(device, &info, nullptr, &sampler);
 	if (result != VK_SUCCESS) {
-		PrintVkError(result);
-		throw std::runtime_error("failed to create descriptor pool!");
+	 	PrintVkError(result);
+	 	throw std::runtime_error("failed to create texture sampler!");
+	}
+	samplers.push_back({info, sampler, 1});
+	return sampler;
+}
+
+void BaseProject::releaseSampler(VkSampler sampler) {
+	if(sampler == VK_NULL_HANDLE) {
+		return;
+	}
+	for(int i = 0; i < samplers.size(); i++) {
+		if(samplers[i].sampler == sampler) {
+			samplerRefs--;
+			if(--samplers[i].refs == 0) {
+				vkDestroySampler(device, sampler, nullptr);
+				samplers.erase(samplers.begin() + i);
+			}
+			return;
+		}
 	}
+	std::cout << "Release of a sampler that is not in the cache\n";
+}
+
+int BaseProject::samplerCount() const {
+	return samplers.size();
 }
 
 void BaseProject::submitCommandBuffer(std::string name, int order, pNCBfunc populateNewCommandBuffer, void *params, pNCBfree onErase) {
@@ -2052,8 +2318,8 @@ void BaseProject::recreateSwapChain() {
 	createSwapChain();
 	createImageViews();
 
-	createDescriptorPool();			
 	pipelinesAndDescriptorSetsInit();
+	descriptors.printStats("Descriptor sets");
 
 	resetCommandBuffers();
 }
@@ -2069,13 +2335,20 @@ void BaseProject::cleanupSwapChain() {
 	
 	vkDestroySwapchainKHR(device, swapChain, nullptr);
 
-	vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+	// the pools are kept for the new sets
+	descriptors.reset();
 }
 	
 void BaseProject::cleanup() {
 	cleanupSwapChain();
 		
 	localCleanup();
+	descriptors.cleanup();
+	for(auto &S : samplers) {
+		std::cout << "Sampler still in use by " << S.refs << " at exit\n";
+		vkDestroySampler(device, S.sampler, nullptr);
+	}
+	samplers.clear();
 	
 	for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
 		vkDestroySemaphore(device, renderFinishedSemaphores[i], nullptr);
@@ -3408,6 +3681,28 @@ void Model::cleanup() {
    	vkFreeMemory(BP->device, vertexBufferMemory, nullptr);
 }
 
+// Local bounding sphere (center, radius), computed at the first call
+glm::vec4 Model::getBounds() {
+	if((bounds.w == 0.0f) && VD->Position.hasIt && !vertices.empty()) {
+		int stride = VD->Bindings[0].stride;
+		glm::vec3 bmin(1e30f), bmax(-1e30f);
+		for(int v = 0; v < vertices.size() / stride; v++) {
+			glm::vec3 p = *(glm::vec3 *)(&vertices[v * stride + VD->Position.offset]);
+			bmin = glm::min(bmin, p);
+			bmax = glm::max(bmax, p);
+		}
+		bounds = glm::vec4((bmin + bmax) * 0.5f, glm::length(bmax - bmin) * 0.5f);
+	}
+	return bounds;
+}
+
+ModelLOD Model::getLOD(int lod) {
+	if(LODs.empty()) {
+		return {0, static_cast<uint32_t>(indices.size()), 0.0f};
+	}
+	return LODs[std::clamp(lod, 0, (int)LODs.size() - 1)];
+}
+
 void Model::bind(VkCommandBuffer commandBuffer) {
 	VkBuffer vertexBuffers[] = {vertexBuffer};
 	// property .vertexBuffer of models, contains the VkBuffer handle to its vertex buffer
@@ -3508,6 +3803,21 @@ void Texture::createTextureSampler(VkFilter magFilter,
 							 VkBool32 anisotropyEnable,
 							 float maxAnisotropy,
 							 float maxLod) {
+	BP->releaseSampler(textureSampler);
+	textureSampler = BP->getSampler(samplerCreateInfo(magFilter, minFilter, addressModeU, addressModeV,
+													  mipmapMode, anisotropyEnable, maxAnisotropy, maxLod));
+}
+
+// maxLod -1: all the levels of the view, so that the textures with any number of mip
+// levels share the sampler
+VkSamplerCreateInfo Texture::samplerCreateInfo(VkFilter magFilter,
+							 VkFilter minFilter,
+							 VkSamplerAddressMode addressModeU,
+							 VkSamplerAddressMode addressModeV,
+							 VkSamplerMipmapMode mipmapMode,
+							 VkBool32 anisotropyEnable,
+							 float maxAnisotropy,
+							 float maxLod) {
 	VkSamplerCreateInfo samplerInfo{};
 	samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
 	samplerInfo.magFilter = magFilter;
@@ -3524,14 +3834,8 @@ void Texture::createTextureSampler(VkFilter magFilter,
 	samplerInfo.mipmapMode = mipmapMode;
 	samplerInfo.mipLodBias = 0.0f;
 	samplerInfo.minLod = 0.0f;
-	samplerInfo.maxLod = ((maxLod == -1) ? static_cast<float>(mipLevels) : maxLod);
-	
-	VkResult result = vkCreateSampler(BP->device, &samplerInfo, nullptr,
-									  &textureSampler);
-	if (result != VK_SUCCESS) {
-	 	PrintVkError(result);
-	 	throw std::runtime_error("failed to create texture sampler!");
-	}
+	samplerInfo.maxLod = ((maxLod == -1) ? VK_LOD_CLAMP_NONE : maxLod);
+	return samplerInfo;
 }
 	
 
@@ -3560,11 +3864,58 @@ void Texture::initCubic(BaseProject *bp, std::vector<std::string>files, VkFormat
 }
 
 VkDescriptorImageInfo Texture::getViewAndSampler() {
-	return {textureSampler, textureImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+	return {textureSampler, textureImageView, layout};
+}
+
+// Cube depth maps to render into (e.g. point light shadows): the cubes are the layers
+// of a cube array, each face has its own view in layerViews, to be used as a
+// framebuffer attachment. The sampler does depth comparisons (samplerCubeArrayShadow)
+void Texture::initDepthCubic(BaseProject *bp, int size, int cubes, VkFormat Fmt) {
+	BP = bp;
+	imgs = 6 * cubes;
+	mipLevels = 1;
+	layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+
+	BP->createImage(size, size, 1, imgs, VK_SAMPLE_COUNT_1_BIT, Fmt,
+				VK_IMAGE_TILING_OPTIMAL,
+				VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+				VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT,
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageMemory);
+	textureImageView = BP->createImageView(textureImage, Fmt, VK_IMAGE_ASPECT_DEPTH_BIT, 1,
+								VK_IMAGE_VIEW_TYPE_CUBE_ARRAY, imgs);
+	layerViews.resize(imgs);
+	for(int i = 0; i < imgs; i++) {
+		layerViews[i] = BP->createImageView(textureImage, Fmt, VK_IMAGE_ASPECT_DEPTH_BIT, 1,
+								VK_IMAGE_VIEW_TYPE_2D, 1, i);
+	}
+
+	VkSamplerCreateInfo samplerInfo{};
+	samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	samplerInfo.magFilter = VK_FILTER_LINEAR;
+	samplerInfo.minFilter = VK_FILTER_LINEAR;
+	samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerInfo.anisotropyEnable = VK_FALSE;
+	samplerInfo.maxAnisotropy = 1.0f;
+	samplerInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+	samplerInfo.unnormalizedCoordinates = VK_FALSE;
+	samplerInfo.compareEnable = VK_TRUE;
+	samplerInfo.compareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+	samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+	samplerInfo.mipLodBias = 0.0f;
+	samplerInfo.minLod = 0.0f;
+	samplerInfo.maxLod = 0.0f;
+	textureSampler = BP->getSampler(samplerInfo);
 }
 
 void Texture::cleanup() {
-   	vkDestroySampler(BP->device, textureSampler, nullptr);
+	for(auto &v : layerViews) {
+		vkDestroyImageView(BP->device, v, nullptr);
+	}
+	layerViews.clear();
+	BP->releaseSampler(textureSampler);
+	textureSampler = VK_NULL_HANDLE;
    	vkDestroyImageView(BP->device, textureImageView, nullptr);
 	vkDestroyImage(BP->device, textureImage, nullptr);
 	vkFreeMemory(BP->device, textureImageMemory, nullptr);
@@ -3584,32 +3935,9 @@ VkFilter magFilter,
 							 float maxAnisotropy,
 							 float maxLod
 							) {
-	BaseProject *BP = RP->BP;
-
-	VkSamplerCreateInfo samplerInfo{};
-	samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
-	samplerInfo.magFilter = magFilter;
-	samplerInfo.minFilter = minFilter;
-	samplerInfo.addressModeU = addressModeU;
-	samplerInfo.addressModeV = addressModeV;
-	samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-	samplerInfo.anisotropyEnable = anisotropyEnable;
-	samplerInfo.maxAnisotropy = maxAnisotropy;
-	samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
-	samplerInfo.unnormalizedCoordinates = VK_FALSE;
-	samplerInfo.compareEnable = VK_FALSE;
-	samplerInfo.compareOp = VK_COMPARE_OP_ALWAYS;
-	samplerInfo.mipmapMode = mipmapMode;
-	samplerInfo.mipLodBias = 0.0f;
-	samplerInfo.minLod = 0.0f;
-	samplerInfo.maxLod = 1.0f;
-	
-	VkResult result = vkCreateSampler(BP->device, &samplerInfo, nullptr,
-									  &sampler);
-	if (result != VK_SUCCESS) {
-	 	PrintVkError(result);
-	 	throw std::runtime_error("failed to create texture sampler!");
-	}
+	// maxLod is always 1: the attachments have a single level
+	sampler = RP->BP->getSampler(Texture::samplerCreateInfo(magFilter, minFilter, addressModeU, addressModeV,
+															 mipmapMode, anisotropyEnable, maxAnisotropy, 1.0f));
 }
 
 void FrameBufferAttachment::init(RenderPass *rp, AttachmentProperties *p, bool initSampler) {
@@ -3665,6 +3993,8 @@ VkImageView FrameBufferAttachment::getView(int currentImage) {
 	
 	if(properties->swapChain) {
 		return BP->swapChainImageViews[currentImage];
+	} else if(!views.empty()) {
+		return views[currentImage];
 	} else {
 		return view;
 	}
@@ -3681,7 +4011,7 @@ void FrameBufferAttachment::cleanup() {
 
 //std::cout << "Cleaning up render pass attchment " << properties->swapChain << " " << properties->type << " " << properties->usage << "\n";
 
-	if(!properties->swapChain) {
+	if(!properties->swapChain && views.empty()) {
 		vkDestroyImageView(BP->device, view, nullptr);
 		vkDestroyImage(BP->device, image, nullptr);
 		vkFreeMemory(BP->device, mem, nullptr);
@@ -3691,7 +4021,7 @@ void FrameBufferAttachment::cleanup() {
 void FrameBufferAttachment::destroy() {
 	BaseProject *BP = RP->BP;
 	if(freeSampler) {
-		vkDestroySampler(BP->device, sampler, nullptr);
+		BP->releaseSampler(sampler);
 	}
 }
 
@@ -3748,7 +4078,9 @@ void RenderPass::createRenderPass() {
 	VkSubpassDescription subpass{};
 	subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
 	subpass.colorAttachmentCount = colorAttchementsCount;
-	subpass.pColorAttachments = &attachments[firstColorAttIdx].ref;
+	if(firstColorAttIdx >= 0) {
+		subpass.pColorAttachments = &attachments[firstColorAttIdx].ref;
+	}
 	if(depthAttIdx >= 0) {
 		subpass.pDepthStencilAttachment = &attachments[depthAttIdx].ref;
 	}
@@ -3815,7 +4147,7 @@ void RenderPass::create() {
 
 	for(int i = 0; i < attachments.size(); i++) {
 //		if(properties[i].type != RESOLVE_AT) {
-		if(!properties[i].swapChain) {
+		if(!properties[i].swapChain && attachments[i].views.empty()) {
 			attachments[i].createResources();
 		}
 	}	
@@ -4089,6 +4421,10 @@ void Pipeline::init(BaseProject *bp, VertexDescriptor *vd,
  	CM = VK_CULL_MODE_BACK_BIT;
  	transp = false;
 	topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+	depthWrite = true;
+	colorWrite = true;
+	depthBiasConstant = depthBiasSlope = 0.0f;
+	SV.clear();
 
 	D = d;
 	PK = pk;
@@ -4114,14 +4450,123 @@ void Pipeline::setTopology(VkPrimitiveTopology _topology) {
  	topology = _topology;
 }
 
+void Pipeline::setDepthWrite(bool _depthWrite) {
+ 	depthWrite = _depthWrite;
+}
+
+// a pipeline without color writes only lays down depth (e.g. a depth pre-pass)
+void Pipeline::setColorWrite(bool _colorWrite) {
+ 	colorWrite = _colorWrite;
+}
+
+// e.g. for shadow maps, to avoid self shadowing
+void Pipeline::setDepthBias(float constant, float slope) {
+	depthBiasConstant = constant;
+	depthBiasSlope = slope;
+}
+
+// Replaces the fragment shader with its 16 bit float version if the device supports it,
+// otherwise keeps the 32 bit one. To be called after init() and before variant()
+bool Pipeline::setHalfPrecisionShader(const std::string& FragShader16) {
+	if(!BP->shaderFloat16) {
+		return false;
+	}
+	auto fragShaderCode = readFile(FragShader16);
+	std::cout << "Fragment shader <" << FragShader16 << "> (fp16) len: " <<
+				fragShaderCode.size() << "\n";
+	vkDestroyShaderModule(BP->device, fragShaderModule, nullptr);
+	fragShaderModule = createShaderModule(fragShaderCode);
+	halfPrecision = true;
+	return true;
+}
+
+// To be called before create()
+void Pipeline::setSpecialization(VkShaderStageFlagBits stage, uint32_t id, uint32_t value) {
+	for(auto &sv : SV) {
+		if((sv.stage == stage) && (sv.id == id)) {
+			sv.value = value;
+			return;
+		}
+	}
+	SV.push_back({stage, id, value});
+}
+
+void Pipeline::setSpecialization(VkShaderStageFlagBits stage, uint32_t id, float value) {
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	setSpecialization(stage, id, bits);
+}
+
+// The pipeline with these constants changed, created only once for every set of values.
+// To be called before create(): the variants are created together with this pipeline
+Pipeline *Pipeline::variant(std::vector<SpecializationValue> values) {
+	Pipeline *root = (base != nullptr) ? base : this;
+
+	std::vector<SpecializationValue> all = SV;
+	for(auto &v : values) {
+		bool found = false;
+		for(auto &sv : all) {
+			if((sv.stage == v.stage) && (sv.id == v.id)) {
+				sv.value = v.value;
+				found = true;
+			}
+		}
+		if(!found) {
+			all.push_back(v);
+		}
+	}
+	std::sort(all.begin(), all.end(), [](const SpecializationValue &a, const SpecializationValue &b) {
+		return (a.stage < b.stage) || ((a.stage == b.stage) && (a.id < b.id));
+	});
+
+	std::vector<uint32_t> key;
+	for(auto &sv : all) {
+		key.insert(key.end(), {(uint32_t)sv.stage, sv.id, sv.value});
+	}
+	auto v = root->variants.find(key);
+	if(v != root->variants.end()) {
+		return v->second;
+	}
+
+	Pipeline *P = new Pipeline(*root);
+	P->SV = all;
+	P->variants.clear();
+	P->base = root;
+	root->variants[key] = P;
+	return P;
+}
+
 
 void Pipeline::create(RenderPass *RP) {	
+	for(auto &v : variants) {
+		v.second->create(RP);
+	}
+
+	// specialization constants of each stage
+	std::vector<VkSpecializationMapEntry> specEntries[2];
+	std::vector<uint32_t> specData[2];
+	VkSpecializationInfo specInfo[2];
+	for(int st = 0; st < 2; st++) {
+		VkShaderStageFlagBits stage = (st == 0) ? VK_SHADER_STAGE_VERTEX_BIT : VK_SHADER_STAGE_FRAGMENT_BIT;
+		for(auto &sv : SV) {
+			if(sv.stage == stage) {
+				specEntries[st].push_back({sv.id, (uint32_t)(specData[st].size() * sizeof(uint32_t)), sizeof(uint32_t)});
+				specData[st].push_back(sv.value);
+			}
+		}
+		specInfo[st].mapEntryCount = static_cast<uint32_t>(specEntries[st].size());
+		specInfo[st].pMapEntries = specEntries[st].data();
+		specInfo[st].dataSize = specData[st].size() * sizeof(uint32_t);
+		specInfo[st].pData = specData[st].data();
+	}
+
 	VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
     vertShaderStageInfo.sType =
     		VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
     vertShaderStageInfo.module = vertShaderModule;
     vertShaderStageInfo.pName = "main";
+    vertShaderStageInfo.pSpecializationInfo = specEntries[0].empty() ? nullptr : &specInfo[0];
 
     VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
     fragShaderStageInfo.sType =
@@ -4129,6 +4574,7 @@ void Pipeline::create(RenderPass *RP) {
     fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
     fragShaderStageInfo.module = fragShaderModule;
     fragShaderStageInfo.pName = "main";
+    fragShaderStageInfo.pSpecializationInfo = specEntries[1].empty() ? nullptr : &specInfo[1];
 
     VkPipelineShaderStageCreateInfo shaderStages[] =
     		{vertShaderStageInfo, fragShaderStageInfo};
@@ -4181,15 +4627,17 @@ void Pipeline::create(RenderPass *RP) {
 	rasterizer.lineWidth = 1.0f;
 	rasterizer.cullMode = CM;
 	rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
-	rasterizer.depthBiasEnable = VK_FALSE;
-	rasterizer.depthBiasConstantFactor = 0.0f; // Optional
+	rasterizer.depthBiasEnable = (depthBiasConstant != 0.0f) || (depthBiasSlope != 0.0f);
+	rasterizer.depthBiasConstantFactor = depthBiasConstant;
 	rasterizer.depthBiasClamp = 0.0f; // Optional
-	rasterizer.depthBiasSlopeFactor = 0.0f; // Optional
+	rasterizer.depthBiasSlopeFactor = depthBiasSlope;
 	
 	int colorAttId = RP->firstColorAttIdx;
 	VkSampleCountFlagBits samples;
 	if(colorAttId >= 0) {
 		samples = RP->attachments[colorAttId].properties->samples;
+	} else if(RP->depthAttIdx >= 0) {
+		samples = RP->attachments[RP->depthAttIdx].properties->samples;
 	} else {
 		samples = VK_SAMPLE_COUNT_1_BIT;
 	}
@@ -4210,6 +4658,9 @@ void Pipeline::create(RenderPass *RP) {
 			VK_COLOR_COMPONENT_G_BIT |
 			VK_COLOR_COMPONENT_B_BIT |
 			VK_COLOR_COMPONENT_A_BIT;
+	if(!colorWrite) {
+		colorBlendAttachment.colorWriteMask = 0;
+	}
 	colorBlendAttachment.blendEnable = transp ? VK_TRUE : VK_FALSE;
 	colorBlendAttachment.srcColorBlendFactor =
 			transp ? VK_BLEND_FACTOR_SRC_ALPHA : VK_BLEND_FACTOR_ONE;
@@ -4229,7 +4680,8 @@ void Pipeline::create(RenderPass *RP) {
 			VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
 	colorBlending.logicOpEnable = VK_FALSE;
 	colorBlending.logicOp = VK_LOGIC_OP_COPY; // Optional
-	colorBlending.attachmentCount = 1;
+	// depth only render passes (e.g. AT_DEPTH_ONLY) have no color attachments
+	colorBlending.attachmentCount = (RP->colorAttchementsCount > 0) ? 1 : 0;
 	colorBlending.pAttachments = &colorBlendAttachment;
 	colorBlending.blendConstants[0] = 0.0f; // Optional
 	colorBlending.blendConstants[1] = 0.0f; // Optional
@@ -4261,7 +4713,7 @@ void Pipeline::create(RenderPass *RP) {
 	depthStencil.sType = 
 			VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
 	depthStencil.depthTestEnable = VK_TRUE;
-	depthStencil.depthWriteEnable = VK_TRUE;
+	depthStencil.depthWriteEnable = depthWrite ? VK_TRUE : VK_FALSE;
 	depthStencil.depthCompareOp = compareOp;
 	depthStencil.depthBoundsTestEnable = VK_FALSE;
 	depthStencil.minDepthBounds = 0.0f; // Optional
@@ -4299,6 +4751,10 @@ void Pipeline::create(RenderPass *RP) {
 }
 
 void Pipeline::destroy() {
+	for(auto &v : variants) {
+		delete v.second;	// the shader modules are the ones of this pipeline
+	}
+	variants.clear();
 	vkDestroyShaderModule(BP->device, fragShaderModule, nullptr);
 	vkDestroyShaderModule(BP->device, vertShaderModule, nullptr);
 }	
@@ -4329,6 +4785,9 @@ VkShaderModule Pipeline::createShaderModule(const std::vector<char>& code) {
 }
 
 void Pipeline::cleanup() {
+		for(auto &v : variants) {
+			v.second->cleanup();
+		}
 		vkDestroyPipeline(BP->device, graphicsPipeline, nullptr);
 		vkDestroyPipelineLayout(BP->device, pipelineLayout, nullptr);
 }
@@ -4339,6 +4798,7 @@ void DescriptorSetLayout::init(BaseProject *bp, std::vector<DescriptorSetLayoutB
 	imgInfoSize = 0;
 	
 	std::vector<VkDescriptorSetLayoutBinding> binds;
+	std::vector<std::vector<VkSampler>> immutable(B.size());
 	binds.resize(B.size());
 	for(int i = 0; i < B.size(); i++) {
 		binds[i].binding = B[i].binding;
@@ -4346,6 +4806,10 @@ void DescriptorSetLayout::init(BaseProject *bp, std::vector<DescriptorSetLayoutB
 		binds[i].descriptorCount = B[i].count;
 		binds[i].stageFlags = B[i].flags;
 		binds[i].pImmutableSamplers = nullptr;
+		if(B[i].immutableSampler != VK_NULL_HANDLE) {
+			immutable[i].assign(B[i].count, B[i].immutableSampler);
+			binds[i].pImmutableSamplers = immutable[i].data();
+		}
 		if((B[i].type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) && (B[i].linkSize + B[i].count > imgInfoSize)) {
 			imgInfoSize = B[i].linkSize + B[i].count;
 		}
@@ -4368,106 +4832,183 @@ void DescriptorSetLayout::cleanup() {
     	vkDestroyDescriptorSetLayout(BP->device, descriptorSetLayout, nullptr);	
 }
 
+// pool: where the sets are allocated, BaseProject::descriptors if VK_NULL_HANDLE.
+// slot: if not null, the uniform blocks are placed there instead of in their own buffers
 void DescriptorSet::init(BaseProject *bp, DescriptorSetLayout *DSL,
-						 std::vector<VkDescriptorImageInfo>VaSs) {
+						 std::vector<VkDescriptorImageInfo>VaSs,
+						 VkDescriptorPool pool, const UniformSlot *slot) {
+	initBuffers(bp, DSL, slot);
+	
+//std::cout << "Allocating\n";	
+	descriptorSets.resize(BP->swapChainImages.size());
+	if(pool == VK_NULL_HANDLE) {
+		BP->descriptors.allocate(std::vector<DescriptorSetLayout *>(BP->swapChainImages.size(), DSL),
+								 descriptorSets.data());
+	} else {
+		std::vector<VkDescriptorSetLayout> layouts(BP->swapChainImages.size(),
+												   DSL->descriptorSetLayout);
+		VkDescriptorSetAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocInfo.descriptorPool = pool;
+		allocInfo.descriptorSetCount = static_cast<uint32_t>(BP->swapChainImages.size());
+		allocInfo.pSetLayouts = layouts.data();
+		
+		VkResult result = vkAllocateDescriptorSets(BP->device, &allocInfo,
+											descriptorSets.data());
+		if (result != VK_SUCCESS) {
+			PrintVkError(result);
+			throw std::runtime_error("failed to allocate descriptor sets!");
+		}
+	}
+	
+	// all the images in a single update
+	int images = BP->swapChainImages.size();
+	std::vector<VkWriteDescriptorSet> descriptorWrites;
+	std::vector<VkDescriptorBufferInfo> bufferInfo;
+	std::vector<VkDescriptorImageInfo> imageInfo;
+	descriptorWrites.reserve(DSL->Bindings.size() * images);
+	bufferInfo.reserve(DSL->Bindings.size() * images);
+	imageInfo.reserve(imageCount(DSL) * images);
+	for (int i = 0; i < images; i++) {
+		appendWrites(i, VaSs.data(), descriptorWrites, bufferInfo, imageInfo);
+	}
+//std::cout << "Updating descriptor sets\n";	
+	vkUpdateDescriptorSets(BP->device,
+					static_cast<uint32_t>(descriptorWrites.size()),
+					descriptorWrites.data(), 0, nullptr);
+}
+
+// The uniform and storage buffers of every binding and image
+void DescriptorSet::initBuffers(BaseProject *bp, DescriptorSetLayout *DSL, const UniformSlot *slot) {
 	BP = bp;
 	Layout = DSL;
 	
 	int size = DSL->Bindings.size();
-	int imgInfoSize = DSL->imgInfoSize;
-//std::cout << "imgInfoSize: " << imgInfoSize << "(" << size << ")\n";
-	
 	uniformBuffers.resize(size);
 	uniformBuffersMemory.resize(size);
+	offsets.resize(size);
 	toFree.resize(size);
 
+	VkDeviceSize alignment = 0, slotOffset = (slot != nullptr) ? slot->offset : 0;
+	if(slot != nullptr) {
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties(BP->physicalDevice, &properties);
+		alignment = std::max(properties.limits.minUniformBufferOffsetAlignment,
+							 properties.limits.minStorageBufferOffsetAlignment);
+	}
 	for (int j = 0; j < size; j++) {
 		uniformBuffers[j].resize(BP->swapChainImages.size());
 		uniformBuffersMemory[j].resize(BP->swapChainImages.size());
+		offsets[j].assign(BP->swapChainImages.size(), 0);
 //std::cout << j << " " << (DSL->Bindings[j].type) << "\n";
-		if(DSL->Bindings[j].type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) {
+		if((DSL->Bindings[j].type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) ||
+		   (DSL->Bindings[j].type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)) {
 //std::cout << "Uniform size: " << DSL->Bindings[j].linkSize << "\n";
+			VkBufferUsageFlags usage = (DSL->Bindings[j].type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) ?
+										VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT : VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
 			for (size_t i = 0; i < BP->swapChainImages.size(); i++) {
 				VkDeviceSize bufferSize = DSL->Bindings[j].linkSize;
-				BP->createBuffer(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+				if(slot != nullptr) {
+					uniformBuffers[j][i] = slot->buffer;
+					uniformBuffersMemory[j][i] = slot->memory;
+					offsets[j][i] = slotOffset;
+					slotOffset += (bufferSize + alignment - 1) / alignment * alignment;
+					continue;
+				}
+				BP->createBuffer(bufferSize, usage,
 									 	 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
 									 	 VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
 									 	 uniformBuffers[j][i], uniformBuffersMemory[j][i]);
 			}
-			toFree[j] = true;
+			toFree[j] = (slot == nullptr);
 		} else {
 			toFree[j] = false;
 		}
 	}
-	
-	std::vector<VkDescriptorSetLayout> layouts(BP->swapChainImages.size(),
-											   DSL->descriptorSetLayout);
-	VkDescriptorSetAllocateInfo allocInfo{};
-	allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-	allocInfo.descriptorPool = BP->descriptorPool;
-	allocInfo.descriptorSetCount = static_cast<uint32_t>(BP->swapChainImages.size());
-	allocInfo.pSetLayouts = layouts.data();
-//std::cout << "Allocating\n";	
-	descriptorSets.resize(BP->swapChainImages.size());
-	
-	VkResult result = vkAllocateDescriptorSets(BP->device, &allocInfo,
-										descriptorSets.data());
-	if (result != VK_SUCCESS) {
-		PrintVkError(result);
-		throw std::runtime_error("failed to allocate descriptor sets!");
-	}
-	
-	for (size_t i = 0; i < BP->swapChainImages.size(); i++) {
-//std::cout << "Consdering swap chain image " << i << "\n";	
+}
 
-		std::vector<VkWriteDescriptorSet> descriptorWrites(size);
-		std::vector<VkDescriptorBufferInfo> bufferInfo(size);
-		std::vector<VkDescriptorImageInfo> imageInfo(imgInfoSize);
-		for (int j = 0; j < size; j++) {
-//std::cout << "Consdering binding " << j << "\n";	
-			if(DSL->Bindings[j].type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) {
-//std::cout << "Writing uniform buffer " << j <<"\n";			
-				bufferInfo[j].buffer = uniformBuffers[j][i];
-				bufferInfo[j].offset = 0;
-				bufferInfo[j].range = DSL->Bindings[j].linkSize;
-				
-				descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-				descriptorWrites[j].dstSet = descriptorSets[i];
-				descriptorWrites[j].dstBinding = DSL->Bindings[j].binding;
-				descriptorWrites[j].dstArrayElement = 0;
-				descriptorWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-				descriptorWrites[j].descriptorCount = DSL->Bindings[j].count;
-				descriptorWrites[j].pBufferInfo = &bufferInfo[j];
-			} else if(DSL->Bindings[j].type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) {
-//std::cout << "Writing combined image sampler " << j << ", count " << DSL->Bindings[j].count << ", link " << DSL->Bindings[j].linkSize << "\n";
-				for(int k = 0; k < DSL->Bindings[j].count; k++) {
-					int h = DSL->Bindings[j].linkSize + k;
-//std::cout << k << " " << h << " " << (&VaSs[h]) << "\n";
-					VkDescriptorImageInfo VaS = VaSs[h];
-//std::cout << VaS.imageView << " " << VaS.sampler << "\n";
-					imageInfo[h] = VaS;
-/*					imageInfo[h].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-					imageInfo[h].imageView = VaS.textureImageView;
-					imageInfo[h].sampler = VaS.textureSampler;
-*/				}
-//std::cout << "Writing descriptor sets\n";			
-				descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-				descriptorWrites[j].dstSet = descriptorSets[i];
-				descriptorWrites[j].dstBinding = DSL->Bindings[j].binding;
-				descriptorWrites[j].dstArrayElement = 0;
-				descriptorWrites[j].descriptorType =
-											VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-				descriptorWrites[j].descriptorCount = DSL->Bindings[j].count;
-				descriptorWrites[j].pImageInfo = &imageInfo[DSL->Bindings[j].linkSize];
+// Adds to W the writes of the set of image i. They point into BI and II, that must have
+// been reserved for all the writes of the update (they are not allowed to grow)
+void DescriptorSet::appendWrites(int i, const VkDescriptorImageInfo *VaSs,
+								 std::vector<VkWriteDescriptorSet> &W,
+								 std::vector<VkDescriptorBufferInfo> &BI,
+								 std::vector<VkDescriptorImageInfo> &II) {
+	for (int j = 0; j < Layout->Bindings.size(); j++) {
+		const DescriptorSetLayoutBinding &B = Layout->Bindings[j];
+		VkWriteDescriptorSet w{};
+		w.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		w.dstSet = descriptorSets[i];
+		w.dstBinding = B.binding;
+		w.dstArrayElement = 0;
+		w.descriptorType = B.type;
+		w.descriptorCount = B.count;
+		if((B.type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) ||
+		   (B.type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)) {
+			BI.push_back({uniformBuffers[j][i], offsets[j][i], (VkDeviceSize)B.linkSize});
+			w.pBufferInfo = &BI.back();
+		} else if(B.type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) {
+//std::cout << "Writing combined image sampler " << j << ", count " << B.count << ", link " << B.linkSize << "\n";
+			w.pImageInfo = II.data() + II.size();
+			for(int k = 0; k < B.count; k++) {
+				II.push_back(VaSs[B.linkSize + k]);
 			}
-		}		
-//std::cout << "Updating descriptor sets\n";	
-		vkUpdateDescriptorSets(BP->device,
-						static_cast<uint32_t>(descriptorWrites.size()),
-						descriptorWrites.data(), 0, nullptr);
+		} else {
+			continue;
+		}
+		W.push_back(w);
+	}
+}
+
+// Writes the image descriptors again (e.g. a set reused for an instance with other textures)
+void DescriptorSet::updateImages(std::vector<VkDescriptorImageInfo>VaSs) {
+	std::vector<VkWriteDescriptorSet> descriptorWrites;
+	for (size_t i = 0; i < descriptorSets.size(); i++) {
+		for (int j = 0; j < Layout->Bindings.size(); j++) {
+			if(Layout->Bindings[j].type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) {
+				VkWriteDescriptorSet w{};
+				w.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				w.dstSet = descriptorSets[i];
+				w.dstBinding = Layout->Bindings[j].binding;
+				w.dstArrayElement = 0;
+				w.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+				w.descriptorCount = Layout->Bindings[j].count;
+				w.pImageInfo = &VaSs[Layout->Bindings[j].linkSize];
+				descriptorWrites.push_back(w);
+			}
+		}
+	}
+	if(!descriptorWrites.empty()) {
+		vkUpdateDescriptorSets(BP->device, static_cast<uint32_t>(descriptorWrites.size()),
+							   descriptorWrites.data(), 0, nullptr);
 	}
 }
 
+// Bytes taken in a UniformSlot by the blocks of a set with layout DSL
+VkDeviceSize DescriptorSet::slotSize(BaseProject *bp, DescriptorSetLayout *DSL) {
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(bp->physicalDevice, &properties);
+	VkDeviceSize alignment = std::max(properties.limits.minUniformBufferOffsetAlignment,
+									  properties.limits.minStorageBufferOffsetAlignment);
+	VkDeviceSize size = 0;
+	for(auto &B : DSL->Bindings) {
+		if((B.type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) || (B.type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)) {
+			size += (B.linkSize + alignment - 1) / alignment * alignment;
+		}
+	}
+	return size * bp->swapChainImages.size();
+}
+
+// Image descriptors written in a set with layout DSL
+int DescriptorSet::imageCount(DescriptorSetLayout *DSL) {
+	int n = 0;
+	for(auto &B : DSL->Bindings) {
+		if(B.type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) {
+			n += B.count;
+		}
+	}
+	return n;
+}
+
 void DescriptorSet::cleanup() {
 	for(int j = 0; j < uniformBuffers.size(); j++) {
 		if(toFree[j]) {
@@ -4493,10 +5034,352 @@ void DescriptorSet::map(int currentImage, void *src, int slot) {
 
 	int size = Layout->Bindings[slot].linkSize;
 
-	vkMapMemory(BP->device, uniformBuffersMemory[slot][currentImage], 0,
+	vkMapMemory(BP->device, uniformBuffersMemory[slot][currentImage], offsets[slot][currentImage],
+						size, 0, &data);
+	memcpy(data, src, size);
+	vkUnmapMemory(BP->device, uniformBuffersMemory[slot][currentImage]);	
+}
+
+// Copies only the first size bytes (e.g. the used part of a large storage buffer)
+void DescriptorSet::map(int currentImage, void *src, int slot, int size) {
+	void* data;
+
+	if(size <= 0) {
+		return;
+	}
+	size = std::min(size, Layout->Bindings[slot].linkSize);
+
+	vkMapMemory(BP->device, uniformBuffersMemory[slot][currentImage], offsets[slot][currentImage],
 						size, 0, &data);
 	memcpy(data, src, size);
 	vkUnmapMemory(BP->device, uniformBuffersMemory[slot][currentImage]);	
 }
 
+void DescriptorAllocator::init(BaseProject *bp, uint32_t _setsPerPool) {
+	BP = bp;
+	setsPerPool = _setsPerPool;
+}
+
+bool DescriptorAllocator::fits(const Pool &P, uint32_t n, const std::map<VkDescriptorType, uint32_t> &need) {
+	if(P.setsLeft < n) {
+		return false;
+	}
+	for(auto &d : need) {
+		auto l = P.left.find(d.first);
+		if((l == P.left.end()) || (l->second < d.second)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// The first of the following pools with room for n sets with the descriptors need,
+// or a new one
+void DescriptorAllocator::nextPool(uint32_t n, const std::map<VkDescriptorType, uint32_t> &need) {
+	for(int p = current + 1; p < pools.size(); p++) {
+		if(fits(pools[p], n, need)) {
+			current = p;
+			return;
+		}
+	}
+
+	// descriptors per set, when the requests do not need more
+	static const std::map<VkDescriptorType, uint32_t> perSet = {
+		{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1},
+		{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2},
+		{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1}
+	};
+	Pool P;
+	P.sets = P.setsLeft = std::max(setsPerPool, n);
+	for(auto &d : perSet) {
+		P.size[d.first] = d.second * P.sets;
+	}
+	for(auto &d : need) {
+		P.size[d.first] = std::max(P.size[d.first], d.second);
+	}
+	P.left = P.size;
+
+	std::vector<VkDescriptorPoolSize> poolSizes;
+	for(auto &d : P.size) {
+		poolSizes.push_back({d.first, d.second});
+	}
+	VkDescriptorPoolCreateInfo poolInfo{};
+	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+	poolInfo.pPoolSizes = poolSizes.data();
+	poolInfo.maxSets = P.sets;
+	VkResult result = vkCreateDescriptorPool(BP->device, &poolInfo, nullptr, &P.pool);
+	if (result != VK_SUCCESS) {
+		PrintVkError(result);
+		throw std::runtime_error("failed to create descriptor pool!");
+	}
+	pools.push_back(P);
+	current = pools.size() - 1;
+}
+
+// One set for each layout in L, from the same pool
+void DescriptorAllocator::allocate(const std::vector<DescriptorSetLayout *> &L, VkDescriptorSet *out) {
+	if(L.empty()) {
+		return;
+	}
+	uint32_t n = L.size();
+	std::map<VkDescriptorType, uint32_t> need;
+	std::vector<VkDescriptorSetLayout> layouts(n);
+	for(int i = 0; i < n; i++) {
+		for(auto &B : L[i]->Bindings) {
+			need[B.type] += B.count;
+		}
+		layouts[i] = L[i]->descriptorSetLayout;
+	}
+	if((current < 0) || !fits(pools[current], n, need)) {
+		nextPool(n, need);
+	}
+
+	VkDescriptorSetAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocInfo.descriptorPool = pools[current].pool;
+	allocInfo.descriptorSetCount = n;
+	allocInfo.pSetLayouts = layouts.data();
+	VkResult result = vkAllocateDescriptorSets(BP->device, &allocInfo, out);
+	if((result == VK_ERROR_OUT_OF_POOL_MEMORY) || (result == VK_ERROR_FRAGMENTED_POOL)) {
+		// the driver counts differently: this pool is considered full
+		pools[current].setsLeft = 0;
+		nextPool(n, need);
+		allocInfo.descriptorPool = pools[current].pool;
+		result = vkAllocateDescriptorSets(BP->device, &allocInfo, out);
+	}
+	if (result != VK_SUCCESS) {
+		PrintVkError(result);
+		throw std::runtime_error("failed to allocate descriptor sets!");
+	}
+
+	Pool &P = pools[current];
+	P.setsLeft -= n;
+	for(auto &d : need) {
+		P.left[d.first] -= d.second;
+		descriptors[d.first] += d.second;
+	}
+	sets += n;
+}
+
+VkDescriptorSet DescriptorAllocator::allocate(DescriptorSetLayout *L) {
+	VkDescriptorSet DS;
+	allocate(std::vector<DescriptorSetLayout *>(1, L), &DS);
+	return DS;
+}
+
+// All the sets allocated so far are given back: they must not be in use
+void DescriptorAllocator::reset() {
+	for(Pool &P : pools) {
+		vkResetDescriptorPool(BP->device, P.pool, 0);
+		P.setsLeft = P.sets;
+		P.left = P.size;
+	}
+	current = pools.empty() ? -1 : 0;
+	sets = 0;
+	descriptors.clear();
+}
+
+void DescriptorAllocator::cleanup() {
+	for(Pool &P : pools) {
+		vkDestroyDescriptorPool(BP->device, P.pool, nullptr);
+	}
+	pools.clear();
+	current = -1;
+	sets = 0;
+	descriptors.clear();
+}
+
+int DescriptorAllocator::poolCount() const {
+	return pools.size();
+}
+
+void DescriptorAllocator::printStats(const std::string &name) const {
+	auto count = [&](VkDescriptorType t) {
+		auto d = descriptors.find(t);
+		return (d == descriptors.end()) ? 0 : d->second;
+	};
+	uint32_t capacity = 0;
+	for(const Pool &P : pools) {
+		capacity += P.sets;
+	}
+	std::cout << name << ": " << sets << " (" << count(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) << " uniform blocks, " <<
+				 count(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) << " textures, " <<
+				 count(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER) << " storage blocks) in " << pools.size() <<
+				 " pools of " << capacity << " sets\n";
+}
+
+void DescriptorSetBatch::init(BaseProject *bp) {
+	BP = bp;
+	sets.clear();
+	images.clear();
+	imageStart.clear();
+}
+
+// At most setCount sets will be added
+void DescriptorSetBatch::reserve(int setCount) {
+	sets.reserve(setCount);
+	imageStart.reserve(setCount);
+}
+
+// DS is created by create(), with the layout L and the textures VaSs as in DescriptorSet::init()
+void DescriptorSetBatch::add(DescriptorSet *DS, DescriptorSetLayout *L, const std::vector<VkDescriptorImageInfo> &VaSs) {
+	DS->Layout = L;
+	sets.push_back(DS);
+	imageStart.push_back(images.size());
+	images.insert(images.end(), VaSs.begin(), VaSs.end());
+}
+
+// A: where the sets are allocated, the one of the application if null
+void DescriptorSetBatch::create(DescriptorAllocator *A) {
+	if(sets.empty()) {
+		return;
+	}
+	int n = BP->swapChainImages.size();
+
+	std::vector<VkDeviceSize> slotSizes(sets.size());
+	VkDeviceSize total = 0;
+	for(int s = 0; s < sets.size(); s++) {
+		slotSizes[s] = DescriptorSet::slotSize(BP, sets[s]->Layout);
+		total += slotSizes[s];
+	}
+	if(total > 0) {
+		BP->createBuffer(total,
+						 VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+						 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+						 slot.buffer, slot.memory);
+	}
+
+	std::vector<DescriptorSetLayout *> layouts;
+	layouts.reserve(sets.size() * n);
+	int writes = 0, bufferInfos = 0, imageInfos = 0;
+	VkDeviceSize offset = 0;
+	for(int s = 0; s < sets.size(); s++) {
+		DescriptorSetLayout *L = sets[s]->Layout;
+		UniformSlot S = {slot.buffer, slot.memory, offset};
+		sets[s]->initBuffers(BP, L, (slotSizes[s] > 0) ? &S : nullptr);
+		offset += slotSizes[s];
+		for(int i = 0; i < n; i++) {
+			layouts.push_back(L);
+		}
+		writes += L->Bindings.size() * n;
+		bufferInfos += L->Bindings.size() * n;
+		imageInfos += DescriptorSet::imageCount(L) * n;
+	}
+
+	std::vector<VkDescriptorSet> allocated(layouts.size());
+	((A != nullptr) ? A : &BP->descriptors)->allocate(layouts, allocated.data());
+
+	std::vector<VkWriteDescriptorSet> W;
+	std::vector<VkDescriptorBufferInfo> BI;
+	std::vector<VkDescriptorImageInfo> II;
+	W.reserve(writes);
+	BI.reserve(bufferInfos);
+	II.reserve(imageInfos);
+	for(int s = 0; s < sets.size(); s++) {
+		sets[s]->descriptorSets.assign(allocated.begin() + s * n, allocated.begin() + (s + 1) * n);
+		for(int i = 0; i < n; i++) {
+			sets[s]->appendWrites(i, images.data() + imageStart[s], W, BI, II);
+		}
+	}
+	vkUpdateDescriptorSets(BP->device, static_cast<uint32_t>(W.size()), W.data(), 0, nullptr);
+	images.clear();
+	imageStart.clear();
+}
+
+// After the cleanup of the sets
+void DescriptorSetBatch::cleanup() {
+	if(slot.buffer != VK_NULL_HANDLE) {
+		vkDestroyBuffer(BP->device, slot.buffer, nullptr);
+		vkFreeMemory(BP->device, slot.memory, nullptr);
+	}
+	slot = {VK_NULL_HANDLE, VK_NULL_HANDLE, 0};
+	sets.clear();
+	images.clear();
+	imageStart.clear();
+}
+
+void GPUTimer::init(BaseProject *bp) {
+	BP = bp;
+	imageCount = BP->swapChainImages.size();
+
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(BP->physicalDevice, &properties);
+	if(!properties.limits.timestampComputeAndGraphics) {
+		std::cout << "Timestamp queries not supported: GPU times will not be available\n";
+		queryPool = VK_NULL_HANDLE;
+		return;
+	}
+	timestampPeriod = properties.limits.timestampPeriod;
+
+	uint32_t familyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(BP->physicalDevice, &familyCount, nullptr);
+	std::vector<VkQueueFamilyProperties> families(familyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(BP->physicalDevice, &familyCount, families.data());
+	uint32_t validBits = families[BP->findQueueFamilies(BP->physicalDevice).graphicsFamily.value()].timestampValidBits;
+	if(validBits == 0) {
+		std::cout << "Timestamp queries not supported by the graphics queue: GPU times will not be available\n";
+		queryPool = VK_NULL_HANDLE;
+		return;
+	}
+	timestampMask = (validBits >= 64) ? ~0ull : ((1ull << validBits) - 1);
+
+	VkQueryPoolCreateInfo poolInfo{};
+	poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+	poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+	poolInfo.queryCount = 2 * imageCount;
+	VkResult result = vkCreateQueryPool(BP->device, &poolInfo, nullptr, &queryPool);
+	if (result != VK_SUCCESS) {
+	 	PrintVkError(result);
+		throw std::runtime_error("failed to create timestamp query pool!");
+	}
+
+	// queries must be reset before their first use
+	VkCommandBuffer commandBuffer = BP->beginSingleTimeCommands();
+	vkCmdResetQueryPool(commandBuffer, queryPool, 0, 2 * imageCount);
+	BP->endSingleTimeCommands(commandBuffer);
+}
+
+// To be recorded outside of any render pass
+void GPUTimer::begin(VkCommandBuffer commandBuffer, int currentImage) {
+	if(queryPool == VK_NULL_HANDLE) {
+		return;
+	}
+	vkCmdResetQueryPool(commandBuffer, queryPool, 2 * currentImage, 2);
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+						queryPool, 2 * currentImage);
+}
+
+void GPUTimer::end(VkCommandBuffer commandBuffer, int currentImage) {
+	if(queryPool == VK_NULL_HANDLE) {
+		return;
+	}
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+						queryPool, 2 * currentImage + 1);
+}
+
+// Time of the last completed submission of the image, false if not yet available
+bool GPUTimer::read(int currentImage, double &ms) {
+	if(queryPool == VK_NULL_HANDLE) {
+		return false;
+	}
+	uint64_t ts[2];
+	VkResult result = vkGetQueryPoolResults(BP->device, queryPool, 2 * currentImage, 2,
+						sizeof(ts), ts, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+	if(result != VK_SUCCESS) {
+		return false;
+	}
+	// the bits above timestampValidBits are undefined; masking the difference also
+	// handles a counter that wrapped between the two
+	ms = (double)(((ts[1] & timestampMask) - (ts[0] & timestampMask)) & timestampMask) * timestampPeriod * 1e-6;
+	return true;
+}
+
+void GPUTimer::cleanup() {
+	if(queryPool != VK_NULL_HANDLE) {
+		vkDestroyQueryPool(BP->device, queryPool, nullptr);
+		queryPool = VK_NULL_HANDLE;
+	}
+}
+
 #endif
\ No newline at end of file
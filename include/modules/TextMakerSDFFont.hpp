@@ -0,0 +1,302 @@
+// Generated by tools/MakeSDFFont.cpp from assets/textures/Fonts.png: do not edit
+
+#ifdef TEXTMAKER_IMPLEMENTATION
+extern constexpr SDFFont sdfFont = {
+	32, 126, 512, 512,
+	"assets/textures/FontsSDF.png",
+	2.0f, 8.0f,
+	{49, 52, 53},
+{
+{48,{
+{0,0,0,0,0,0,26},
+{203,268,18,29,-3,-1,26},
+{123,412,21,21,-6,-1,26},
+{1,329,25,29,-11,0,26},
+{274,40,24,33,-10,-4,26},
+{378,40,25,33,-10,-4,26},
+{315,205,26,30,-11,-1,26},
+{165,412,17,21,-2,-1,26},
+{462,40,21,33,-4,-4,26},
+{484,40,21,33,-8,-4,26},
+{396,359,24,25,-9,4,26},
+{421,359,25,25,-10,4,26},
+{145,412,19,21,-4,23,26},
+{136,438,23,16,-8,17,26},
+{443,412,18,17,-3,23,26},
+{437,40,24,33,-10,-4,26},
+{442,205,25,30,-10,-1,26},
+{136,329,22,29,-7,-1,26},
+{110,329,25,29,-10,-1,26},
+{105,268,25,30,-10,-1,26},
+{83,329,26,29,-11,-1,26},
+{57,329,25,29,-10,0,26},
+{79,268,25,30,-10,-1,26},
+{53,268,25,30,-10,-1,26},
+{27,268,25,30,-10,-1,26},
+{1,268,25,30,-10,-1,26},
+{236,359,18,25,-3,8,26},
+{212,329,19,28,-4,8,26},
+{485,329,24,26,-10,3,26},
+{264,412,25,19,-11,9,26},
+{24,359,24,26,-10,3,26},
+{108,299,24,29,-9,-1,26},
+{247,268,25,29,-10,-1,26},
+{273,268,26,29,-11,-1,26},
+{300,268,25,29,-11,0,26},
+{324,237,25,30,-10,-1,26},
+{326,268,25,29,-11,0,26},
+{352,268,26,29,-11,0,26},
+{379,268,26,29,-11,0,26},
+{297,237,26,30,-11,-1,26},
+{406,268,26,29,-11,0,26},
+{433,268,23,29,-9,0,26},
+{457,268,24,29,-9,0,26},
+{482,268,26,29,-11,0,26},
+{1,299,26,29,-11,0,26},
+{28,299,26,29,-12,0,26},
+{55,299,26,29,-11,0,26},
+{213,237,25,30,-10,-1,26},
+{82,299,25,29,-11,0,26},
+{158,40,25,33,-10,-1,26},
+{238,299,26,29,-11,0,26},
+{156,237,25,30,-10,-1,26},
+{265,299,26,29,-11,0,26},
+{319,299,27,29,-12,0,26},
+{347,299,26,29,-12,0,26},
+{401,299,27,29,-12,0,26},
+{429,299,26,29,-11,0,26},
+{456,299,26,29,-11,0,26},
+{483,299,25,29,-10,0,26},
+{299,40,21,33,-2,-4,26},
+{249,40,24,33,-10,-4,26},
+{184,40,21,33,-10,-4,26},
+{418,412,24,18,-9,2,26},
+{44,438,25,16,-10,30,26},
+{398,412,19,18,-7,-2,26},
+{157,359,26,25,-10,8,26},
+{374,299,26,29,-12,0,26},
+{355,386,24,25,-9,8,26},
+{292,299,26,29,-11,0,26},
+{19,412,24,25,-10,8,26},
+{213,299,24,29,-10,-1,26},
+{27,237,26,30,-11,8,26},
+{185,299,27,29,-12,0,26},
+{160,299,24,29,-9,0,26},
+{110,40,22,34,-10,0,26},
+{133,299,26,29,-11,0,26},
+{222,268,24,29,-10,0,26},
+{459,386,27,25,-13,8,26},
+{431,386,27,25,-12,8,26},
+{406,386,24,25,-10,8,26},
+{102,237,26,30,-12,8,26},
+{129,237,26,30,-10,8,26},
+{380,386,25,25,-11,8,26},
+{330,386,24,25,-9,8,26},
+{232,329,25,28,-11,2,26},
+{260,386,27,25,-12,8,26},
+{233,386,26,25,-11,8,26},
+{206,386,26,25,-12,8,26},
+{179,386,26,25,-11,8,26},
+{239,237,26,30,-11,8,26},
+{153,386,25,25,-11,8,26},
+{133,40,24,33,-10,-4,26},
+{206,40,17,33,-2,-4,26},
+{224,40,24,33,-10,-4,26},
+{1,438,24,17,-9,0,26}}},
+{48,{
+{0,0,0,0,0,0,16},
+{401,76,17,32,-7,-3,16},
+{62,412,20,23,-6,-3,24},
+{394,1,31,37,-9,-3,40},
+{321,40,24,33,-10,-4,24},
+{404,40,32,33,-10,-4,40},
+{346,40,31,33,-11,-4,37},
+{44,412,17,23,-8,-3,14},
+{133,1,21,38,-9,-4,19},
+{217,1,21,38,-10,-4,19},
+{26,386,23,25,-9,-4,24},
+{350,237,31,30,-10,4,38},
+{290,412,17,19,-8,28,14},
+{114,438,21,16,-12,20,16},
+{96,438,17,16,-8,28,14},
+{264,1,24,38,-10,-4,24},
+{78,109,25,31,-11,-1,24},
+{54,109,23,31,-8,-1,24},
+{29,109,24,31,-10,-1,24},
+{265,109,24,31,-10,-1,24},
+{433,237,25,30,-11,1,24},
+{459,237,25,30,-11,1,24},
+{361,141,24,31,-10,-1,24},
+{485,237,25,30,-11,1,24},
+{311,141,24,31,-10,-1,24},
+{286,141,24,31,-10,-1,24},
+{312,386,17,25,-8,11,14},
+{258,329,17,28,-8,11,14},
+{159,329,29,29,-8,5,38},
+{201,412,31,20,-10,14,38},
+{27,329,29,29,-8,5,38},
+{230,76,23,32,-10,-3,23},
+{201,76,28,32,-10,-3,33},
+{111,141,29,31,-11,-1,33},
+{83,141,27,31,-8,-1,33},
+{173,76,27,32,-9,-2,31},
+{28,141,28,31,-8,-1,35},
+{1,141,26,31,-8,-1,29},
+{57,141,25,31,-8,-1,28},
+{120,76,27,32,-9,-2,33},
+{169,141,27,31,-8,-1,34},
+{488,109,17,31,-8,-1,14},
+{233,141,23,31,-10,-1,23},
+{257,141,28,31,-8,-1,34},
+{336,141,24,31,-8,-1,27},
+{386,141,31,31,-8,-1,42},
+{418,141,27,31,-8,-1,34},
+{27,76,30,32,-10,-2,36},
+{157,109,26,31,-8,-1,31},
+{22,40,30,34,-10,-2,36},
+{355,109,27,31,-8,-1,32},
+{1,76,25,32,-10,-2,27},
+{1,205,29,31,-11,-1,33},
+{255,205,27,31,-8,-1,33},
+{225,205,29,31,-11,-1,33},
+{93,205,36,31,-11,-1,46},
+{31,205,29,31,-11,-1,33},
+{442,173,30,31,-12,-1,33},
+{414,173,27,31,-10,-1,30},
+{374,1,19,38,-8,-4,14},
+{325,1,24,38,-10,-4,24},
+{289,1,18,38,-11,-4,14},
+{308,412,23,19,-6,2,30},
+{182,438,29,15,-8,42,38},
+{357,412,20,18,-8,1,24},
+{411,329,23,26,-10,10,24},
+{148,76,24,32,-9,-3,25},
+{460,329,24,26,-11,10,22},
+{376,76,24,32,-11,-3,25},
+{435,329,24,26,-11,10,22},
+{353,76,22,32,-11,-3,15},
+{388,205,25,30,-11,10,24},
+{286,76,23,32,-9,-3,25},
+{197,141,17,31,-9,-1,12},
+{458,1,20,36,-15,-1,13},
+{310,76,24,32,-9,-3,24},
+{335,76,17,32,-9,-3,12},
+{447,359,30,25,-9,10,39},
+{487,386,23,25,-9,10,25},
+{385,329,25,26,-11,10,24},
+{342,205,24,30,-9,10,25},
+{408,237,24,30,-11,10,25},
+{131,386,21,25,-9,10,17},
+{1,359,22,26,-11,10,19},
+{189,329,22,28,-12,5,18},
+{107,386,23,25,-9,11,25},
+{81,386,25,25,-12,11,23},
+{50,386,30,25,-11,11,33},
+{478,359,25,25,-12,11,23},
+{382,237,25,30,-12,11,23},
+{1,386,24,25,-11,11,21},
+{239,1,24,38,-10,-4,24},
+{116,1,16,38,-7,-4,14},
+{91,1,24,38,-10,-4,24},
+{462,412,25,17,-8,0,30}}},
+{48,{
+{0,0,0,0,0,0,16},
+{215,141,17,31,-8,-1,14},
+{83,412,21,23,-7,-1,24},
+{479,1,31,35,-9,0,40},
+{53,40,24,34,-10,-3,24},
+{78,40,31,34,-9,-3,40},
+{254,76,31,32,-10,-1,38},
+{105,412,17,23,-8,-1,14},
+{70,1,20,38,-8,-3,19},
+{49,1,20,38,-10,-3,19},
+{288,386,23,25,-9,-3,24},
+{182,237,30,30,-9,5,38},
+{183,412,17,21,-8,28,14},
+{160,438,21,16,-12,21,16},
+{26,438,17,17,-8,28,14},
+{25,1,23,38,-9,-3,24},
+{473,173,25,31,-11,1,24},
+{79,237,22,30,-8,1,24},
+{54,237,24,30,-10,1,24},
+{185,173,24,31,-10,1,24},
+{1,173,25,31,-11,0,24},
+{27,173,24,31,-10,1,24},
+{84,173,24,31,-10,1,24},
+{109,173,25,31,-10,1,24},
+{135,173,24,31,-10,1,24},
+{160,173,24,31,-10,1,24},
+{1,412,17,25,-8,12,14},
+{185,268,17,29,-8,12,14},
+{306,329,29,27,-8,8,38},
+{233,412,30,19,-9,16,38},
+{276,329,29,27,-8,8,38},
+{446,141,23,31,-10,-1,23},
+{88,76,31,32,-10,-1,38},
+{236,173,31,31,-11,-1,36},
+{268,173,29,31,-11,0,34},
+{58,76,29,32,-10,-1,35},
+{321,173,31,31,-11,0,37},
+{127,109,29,31,-11,0,33},
+{385,173,28,31,-11,0,32},
+{419,76,31,32,-10,-1,38},
+{353,173,31,31,-11,0,36},
+{298,173,22,31,-11,0,18},
+{210,173,25,31,-10,0,25},
+{52,173,31,31,-11,0,38},
+{130,205,28,31,-11,0,30},
+{189,205,35,31,-11,0,44},
+{283,205,31,31,-11,0,36},
+{477,76,31,32,-10,-1,38},
+{159,205,29,31,-11,0,33},
+{426,1,31,36,-10,-1,38},
+{61,205,31,31,-11,0,36},
+{451,76,25,32,-10,-1,27},
+{266,237,30,30,-10,1,35},
+{456,109,31,31,-11,0,36},
+{423,109,32,31,-12,0,36},
+{383,109,39,31,-12,0,50},
+{323,109,31,31,-11,0,36},
+{290,109,32,31,-12,0,36},
+{1,109,27,31,-10,0,30},
+{155,1,18,38,-8,-3,14},
+{174,1,23,38,-9,-3,24},
+{198,1,18,38,-11,-3,14},
+{332,412,24,18,-7,3,30},
+{212,438,29,15,-8,42,38},
+{378,412,19,18,-8,2,24},
+{359,329,25,26,-10,11,24},
+{238,109,26,31,-11,0,27},
+{75,359,24,26,-11,11,22},
+{211,109,26,31,-11,0,27},
+{100,359,24,26,-11,11,22},
+{104,109,22,31,-11,-1,15},
+{1,237,25,30,-11,11,24},
+{141,141,27,31,-11,0,27},
+{367,205,20,30,-11,1,14},
+{1,40,20,35,-14,1,15},
+{184,109,26,31,-11,0,26},
+{470,141,20,31,-11,0,14},
+{278,359,33,25,-11,12,40},
+{312,359,27,25,-11,12,27},
+{49,359,25,26,-11,11,24},
+{131,268,26,29,-11,12,27},
+{158,268,26,29,-11,12,26},
+{255,359,22,25,-11,12,19},
+{336,329,22,26,-11,11,19},
+{468,205,22,30,-12,3,19},
+{368,359,27,25,-11,12,27},
+{340,359,27,25,-12,12,26},
+{125,359,31,25,-12,12,35},
+{208,359,27,25,-12,12,26},
+{414,205,27,30,-12,12,26},
+{184,359,23,25,-11,12,22},
+{350,1,23,38,-9,-3,24},
+{308,1,16,38,-7,-3,14},
+{1,1,23,38,-9,-3,24},
+{70,438,25,16,-8,1,30}}}
+}
+};
+#else
+extern const SDFFont sdfFont;
+#endif
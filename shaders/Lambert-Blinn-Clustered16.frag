@@ -0,0 +1,120 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_EXT_shader_explicit_arithmetic_types_float16 : require
+
+// Half precision version of Lambert-Blinn-Clustered.frag: positions and distances stay in 32 bits,
+// directions, light intensities and colors are in 16 bits
+
+layout(location = 0) in vec3 fragPos;
+layout(location = 1) in vec3 fragNorm;
+layout(location = 2) in vec2 fragUV;
+
+layout(location = 0) out vec4 outColor;
+
+// must match include/modules/LightClusters.hpp
+const uvec3 CLUSTERS = uvec3(16, 9, 24);
+
+// specialization constants, see Pipeline::variant()
+layout(constant_id = 0) const int MAX_LIGHTS = 1024;    // per cluster, 0 = no point lights
+layout(constant_id = 1) const bool USE_NOISE = true;
+layout(constant_id = 2) const int SHADOW_LIGHTS = 0;    // the first lights have a shadow map
+
+layout(set = 0, binding = 0) uniform GlobalUniformBufferObject {
+    vec4 lightPos[8];
+    vec4 lightColor;
+    float decayFactor;
+    float g;
+    float numLights;
+	vec3 ambientLightColor;
+	vec3 eyePos;
+	mat4 viewMat;
+	vec4 screen;
+	vec4 clusterZ;
+} gubo;
+
+struct PointLight {
+	vec4 posRadius;
+	vec4 color;
+};
+
+layout(std430, set = 0, binding = 1) readonly buffer Lights {
+	PointLight lights[];
+};
+
+layout(std430, set = 0, binding = 2) readonly buffer Clusters {
+	uvec2 clusters[];	// offset, count in lightIndices
+};
+
+layout(std430, set = 0, binding = 3) readonly buffer LightIndices {
+	uint lightIndices[];
+};
+
+layout(set = 0, binding = 4) uniform samplerCubeArrayShadow shadowMaps;   // one cube per shadowed light
+
+// must match include/modules/ShadowMaps.hpp
+const float SHADOW_NEAR = 0.05;
+
+// 1 = lit, 0 = occluded. L goes from the fragment to light l, far is its radius
+float shadowFactor(uint l, vec3 L, float far) {
+	if (l >= uint(SHADOW_LIGHTS)) {
+		return 1.0;
+	}
+	vec3 a = abs(L);
+	float z = max(a.x, max(a.y, a.z));     // depth in the cube face seen by the fragment
+	float ref = far / (far - SHADOW_NEAR) - far * SHADOW_NEAR / ((far - SHADOW_NEAR) * z);
+	return texture(shadowMaps, vec4(-L, float(l)), ref);
+}
+
+layout(set = 2, binding = 0) uniform MaterialUniformBufferObject {
+    float gamma;
+    vec3 specularColor;
+} ubo;
+
+layout(set = 2, binding = 1) uniform sampler2D tex;
+layout(set = 2, binding = 2) uniform sampler2D noisetex;
+
+f16vec3 calculateColorForEachLight(uint l, f16vec3 Norm, f16vec3 EyeDir, f16vec3 albedo) {
+	PointLight light = lights[l];
+	vec3 L = light.posRadius.xyz - fragPos;
+	float LightDistance = length(L);
+    f16vec3 LightDir = f16vec3(L / LightDistance);
+
+	// same decay as Lambert-Blinn.frag, smoothly brought to zero at the light radius
+	float16_t w = float16_t(clamp(1.0 - pow(LightDistance / light.posRadius.w, 4.0), 0.0, 1.0));
+	f16vec3 LightModel = f16vec3(light.color.rgb) * float16_t(pow((gubo.g / LightDistance), gubo.decayFactor)) * w * w;
+	LightModel *= float16_t(shadowFactor(l, L, light.posRadius.w));
+
+	f16vec3 MD = albedo;
+	f16vec3 Diffuse = MD * clamp(dot(LightDir, Norm), float16_t(0.0), float16_t(1.0));
+
+	f16vec3 MS = f16vec3(ubo.specularColor);
+	f16vec3 Specular = MS * pow(clamp(dot(Norm, normalize(LightDir + EyeDir)), float16_t(0.0), float16_t(1.0)), float16_t(ubo.gamma));
+
+    return LightModel * (Diffuse + Specular);
+}
+
+void main() {
+    f16vec3 albedo = f16vec3(texture(tex, fragUV).rgb);
+    if (USE_NOISE) {
+        albedo *= (float16_t(5.0) + f16vec3(texture(noisetex, fragPos.xz).rgb)) / float16_t(6.0);
+    }
+    f16vec3 Norm = f16vec3(normalize(fragNorm));
+	f16vec3 EyeDir = f16vec3(normalize(gubo.eyePos - fragPos));
+    f16vec3 color = f16vec3(0.0);
+
+	// cluster of this fragment
+	float depth = -(gubo.viewMat * vec4(fragPos, 1.0)).z;
+	uint cz = uint(clamp(log(max(depth, 1e-4)) * gubo.clusterZ.x + gubo.clusterZ.y, 0.0, float(CLUSTERS.z - 1)));
+	uvec2 cxy = min(uvec2(gl_FragCoord.xy / gubo.screen.xy * vec2(CLUSTERS.xy)), CLUSTERS.xy - 1);
+	uvec2 range = clusters[(cz * CLUSTERS.y + cxy.y) * CLUSTERS.x + cxy.x];
+
+    uint n = min(range.y, uint(MAX_LIGHTS));
+    for (uint i = 0; i < n; ++i) {
+        color += calculateColorForEachLight(lightIndices[range.x + i], Norm, EyeDir, albedo);
+    }
+
+    f16vec3 MA = albedo;
+    f16vec3 Ambient = MA * f16vec3(gubo.ambientLightColor);
+
+	outColor = vec4(vec3(color + Ambient), 1.0f);
+}
@@ -7,6 +7,10 @@ layout(location = 2) in vec2 fragUV;
 
 layout(location = 0) out vec4 outColor;
 
+// specialization constants, see Pipeline::variant(): a constant loop bound can be unrolled
+layout(constant_id = 0) const int NUM_LIGHTS = 8;     // at most 8, the size of lightPos
+layout(constant_id = 1) const bool USE_NOISE = true;
+
 layout(set = 0, binding = 0) uniform GlobalUniformBufferObject {
     vec4 lightPos[8];
     vec4 lightColor;
@@ -17,17 +21,13 @@ layout(set = 0, binding = 0) uniform GlobalUniformBufferObject {
 	vec3 eyePos;
 } gubo;
 
-layout(set = 1, binding = 0) uniform UniformBufferObject {
+layout(set = 2, binding = 0) uniform MaterialUniformBufferObject {
     float gamma;
     vec3 specularColor;
-    mat4 mvpMat;
-    mat4 mMat;
-    mat4 nMat;
-    vec4 visibilityFlag;
 } ubo;
 
-layout(set = 1, binding = 1) uniform sampler2D tex;
-layout(set = 1, binding = 2) uniform sampler2D noisetex;
+layout(set = 2, binding = 1) uniform sampler2D tex;
+layout(set = 2, binding = 2) uniform sampler2D noisetex;
 
 vec3 calculateColorForEachLight(vec4 lightPos, vec3 albedo) {
     vec3 Norm = normalize(fragNorm);
@@ -50,10 +50,13 @@ vec3 calculateColorForEachLight(vec4 lightPos, vec3 albedo) {
 }
 
 void main() {
-    vec3 albedo = texture(tex, fragUV).rgb * (5.0 + texture(noisetex, fragPos.xz).rgb).rgb / 6.0;
+    vec3 albedo = texture(tex, fragUV).rgb;
+    if (USE_NOISE) {
+        albedo *= (5.0 + texture(noisetex, fragPos.xz).rgb) / 6.0;
+    }
     vec3 color = vec3(0.0f);
 
-    for (int i  = 0; i < gubo.numLights; ++i) {
+    for (int i = 0; i < NUM_LIGHTS; ++i) {
         color += calculateColorForEachLight(gubo.lightPos[i], albedo);
     }
 
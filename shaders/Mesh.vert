@@ -1,10 +1,21 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
 
+layout(binding = 0, set = 0) uniform GlobalUniformBufferObject {
+    vec4 lightPos[8];
+    vec4 lightColor;
+    float decayFactor;
+    float g;
+    float numLights;
+    vec3 ambientLightColor;
+    vec3 eyePos;
+    mat4 viewMat;
+    vec4 screen;
+    vec4 clusterZ;
+    mat4 viewPrj;
+} gubo;
+
 layout(binding = 0, set = 1) uniform UniformBufferObject {
-    float gamma;
-    vec3 specularColor;
-    mat4 mvpMat;
     mat4 mMat;
     mat4 nMat;
     vec4 visibilityFlag;
@@ -18,6 +29,9 @@ layout(location = 0) out vec3 fragPos;
 layout(location = 1) out vec3 fragNorm;
 layout(location = 2) out vec2 fragUV;
 
+// must produce exactly the same depth as MeshDepth.vert for the EQUAL test
+invariant gl_Position;
+
 void main() {
 
     if (ubo.visibilityFlag.w < 0.5) {
@@ -25,8 +39,9 @@ void main() {
             return;
         }
 
-	gl_Position = ubo.mvpMat * vec4(inPosition, 1.0);
-	fragPos = (ubo.mMat * vec4(inPosition, 1.0)).xyz;
+	vec4 worldPos = ubo.mMat * vec4(inPosition, 1.0);
+	gl_Position = gubo.viewPrj * worldPos;
+	fragPos = worldPos.xyz;
 	fragNorm = (ubo.nMat * vec4(inNorm, 0.0)).xyz;
 	fragUV = inUV;
 }
\ No newline at end of file
@@ -0,0 +1,39 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+// Depth pre-pass: position only, same transform as Mesh.vert and MeshLM.vert
+
+layout(binding = 0, set = 0) uniform GlobalUniformBufferObject {
+    vec4 lightPos[8];
+    vec4 lightColor;
+    float decayFactor;
+    float g;
+    float numLights;
+    vec3 ambientLightColor;
+    vec3 eyePos;
+    mat4 viewMat;
+    vec4 screen;
+    vec4 clusterZ;
+    mat4 viewPrj;
+} gubo;
+
+layout(binding = 0, set = 1) uniform UniformBufferObject {
+    mat4 mMat;
+    mat4 nMat;
+    vec4 visibilityFlag;
+} ubo;
+
+layout(location = 0) in vec3 inPosition;
+
+invariant gl_Position;
+
+void main() {
+
+    if (ubo.visibilityFlag.w < 0.5) {
+            gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+            return;
+        }
+
+	vec4 worldPos = ubo.mMat * vec4(inPosition, 1.0);
+	gl_Position = gubo.viewPrj * worldPos;
+}
@@ -0,0 +1,51 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(binding = 0, set = 0) uniform GlobalUniformBufferObject {
+    vec4 lightPos[8];
+    vec4 lightColor;
+    float decayFactor;
+    float g;
+    float numLights;
+    vec3 ambientLightColor;
+    vec3 eyePos;
+    mat4 viewMat;
+    vec4 screen;
+    vec4 clusterZ;
+    mat4 viewPrj;
+} gubo;
+
+layout(binding = 0, set = 1) uniform UniformBufferObject {
+    mat4 mMat;
+    mat4 nMat;
+    vec4 visibilityFlag;
+    vec4 lightmapST;    // region of the instance in the lightmap atlas
+} ubo;
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNorm;
+layout(location = 2) in vec2 inUV;
+layout(location = 3) in vec2 inUV2;
+
+layout(location = 0) out vec3 fragPos;
+layout(location = 1) out vec3 fragNorm;
+layout(location = 2) out vec2 fragUV;
+layout(location = 3) out vec2 fragUV2;
+
+// must produce exactly the same depth as MeshDepth.vert for the EQUAL test
+invariant gl_Position;
+
+void main() {
+
+    if (ubo.visibilityFlag.w < 0.5) {
+            gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+            return;
+        }
+
+	vec4 worldPos = ubo.mMat * vec4(inPosition, 1.0);
+	gl_Position = gubo.viewPrj * worldPos;
+	fragPos = worldPos.xyz;
+	fragNorm = (ubo.nMat * vec4(inNorm, 0.0)).xyz;
+	fragUV = inUV;
+	fragUV2 = inUV2 * ubo.lightmapST.xy + ubo.lightmapST.zw;
+}
@@ -0,0 +1,14 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+// Point light shadow maps: one cube face at a time, see include/modules/ShadowMaps.hpp
+
+layout(push_constant) uniform PushConstants {
+    mat4 lightMVP;      // face projection * face view * world matrix of the instance
+} pc;
+
+layout(location = 0) in vec3 inPosition;
+
+void main() {
+	gl_Position = pc.lightMVP * vec4(inPosition, 1.0);
+}
@@ -0,0 +1,18 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(location = 0) in vec2 fragTexCoord;
+layout(location = 1) flat in vec4 fragFill;
+layout(location = 2) flat in vec4 fragStroke;
+layout(location = 3) flat in vec4 fragShadow;
+
+layout(location = 0) out vec4 outColor;
+
+layout(binding = 0) uniform sampler2D texSampler;
+
+void main() {
+	vec4 Tx = texture(texSampler, fragTexCoord);
+	outColor = Tx.r * fragFill +
+			   Tx.g * fragStroke +
+			   Tx.b * fragShadow;
+}
@@ -0,0 +1,58 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+// Per instance: one character
+layout(location = 0) in vec2 inPos;
+layout(location = 1) in uint inGlyph;	// glyph in the low 16 bits, palette entry in the high 16
+
+layout(location = 0) out vec2 fragTexCoord;
+layout(location = 1) flat out vec4 fragFill;
+layout(location = 2) flat out vec4 fragStroke;
+layout(location = 3) flat out vec4 fragShadow;
+layout(location = 4) flat out vec4 fragStyle;
+
+struct GlyphMetrics {
+	vec4 uv;	// u0, v0, u1, v1
+	vec4 rect;	// xoffset, yoffset, width, height
+};
+
+struct PaletteEntry {
+	vec4 fill;
+	vec4 stroke;
+	vec4 shadow;
+	vec4 scale;
+	vec4 style;	// italic shear, bold edge shift, stroke width, baseline (distance field font only)
+};
+
+layout(std430, binding = 1) readonly buffer GlyphTable {
+	GlyphMetrics glyphs[];
+} gt;
+
+layout(std430, binding = 2) readonly buffer Palette {
+	PaletteEntry entries[];
+} pal;
+
+layout(push_constant) uniform PushConsts {
+	vec2 scale;		// unused: the scale comes from the palette
+	vec2 screen;
+} pushConsts;
+
+void main() {
+	GlyphMetrics g = gt.glyphs[inGlyph & 0xFFFFu];
+	PaletteEntry p = pal.entries[inGlyph >> 16];
+
+	// corners 0..3 of the quad, indexed as 0,1,2 - 1,2,3
+	vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+	vec2 local = g.rect.xy + g.rect.zw * corner;
+	// italic: shear around the baseline
+	local.x -= p.style.x * (local.y - p.style.w);
+	// snapped to whole pixels, as the non-instanced path does
+	vec2 px = floor(inPos + local * p.scale.xy);
+
+	gl_Position = vec4((px + 0.5) / pushConsts.screen * 2.0 - 1.0, 0.0, 1.0);
+	fragTexCoord = mix(g.uv.xy, g.uv.zw, corner);
+	fragFill = p.fill;
+	fragStroke = p.stroke;
+	fragShadow = p.shadow;
+	fragStyle = p.style;
+}
@@ -0,0 +1,34 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+// Per instance: one character
+layout(location = 0) in vec2 inPos;
+layout(location = 1) in uint inGlyph;
+
+layout(location = 0) out vec2 fragTexCoord;
+
+struct GlyphMetrics {
+	vec4 uv;	// u0, v0, u1, v1
+	vec4 rect;	// xoffset, yoffset, width, height
+};
+
+layout(std430, binding = 1) readonly buffer GlyphTable {
+	GlyphMetrics glyphs[];
+} gt;
+
+layout(push_constant) uniform PushConsts {
+	layout(offset = 48) vec2 scale;
+	vec2 screen;
+} pushConsts;
+
+void main() {
+	GlyphMetrics g = gt.glyphs[inGlyph];
+
+	// corners 0..3 of the quad, indexed as 0,1,2 - 1,2,3
+	vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+	// snapped to whole pixels, as the non-instanced path does
+	vec2 px = floor(inPos + (g.rect.xy + g.rect.zw * corner) * pushConsts.scale);
+
+	gl_Position = vec4((px + 0.5) / pushConsts.screen * 2.0 - 1.0, 0.0, 1.0);
+	fragTexCoord = mix(g.uv.xy, g.uv.zw, corner);
+}
@@ -0,0 +1,34 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(location = 0) in vec2 fragTexCoord;
+layout(location = 1) flat in vec4 fragFill;
+layout(location = 2) flat in vec4 fragStroke;
+layout(location = 3) flat in vec4 fragShadow;
+layout(location = 4) flat in vec4 fragStyle;	// italic shear, bold edge shift, stroke width, baseline
+
+layout(location = 0) out vec4 outColor;
+
+// distance field: 0.5 on the glyph edge, larger inside
+layout(binding = 0) uniform sampler2D texSampler;
+
+const vec2 shadowOffset = vec2(1.5, 1.5);	// atlas texels
+
+void main() {
+	float d = texture(texSampler, fragTexCoord).r;
+	float aa = max(fwidth(d), 0.001);
+
+	float edge = 0.5 - fragStyle.y;
+	float outline = edge - fragStyle.z;
+
+	float fill   = smoothstep(edge - aa, edge + aa, d);
+	float stroke = smoothstep(outline - aa, outline + aa, d);
+
+	vec2 texel = 1.0 / vec2(textureSize(texSampler, 0));
+	float ds = texture(texSampler, fragTexCoord - shadowOffset * texel).r;
+	float shadow = smoothstep(outline - 4.0 * aa, outline + aa, ds);
+
+	outColor = fill * fragFill +
+			   (stroke - fill) * fragStroke +
+			   shadow * (1.0 - stroke) * fragShadow;
+}
@@ -9,3 +9,21 @@
 #define  SCENE_IMPLEMENTATION
 #include "modules/Scene.hpp"
 
+#define  LIGHTCLUSTERS_IMPLEMENTATION
+#include "modules/LightClusters.hpp"
+
+
+#define  LIGHTMAPBAKER_IMPLEMENTATION
+#include "modules/LightmapBaker.hpp"
+
+#define  SHADOWMAPS_IMPLEMENTATION
+#include "modules/ShadowMaps.hpp"
+
+#define  MESHSIMPLIFIER_IMPLEMENTATION
+#include "modules/MeshSimplifier.hpp"
+
+#define  CELLPORTALS_IMPLEMENTATION
+#include "modules/CellPortals.hpp"
+
+#define  OCCLUSIONCULLER_IMPLEMENTATION
+#include "modules/OcclusionCuller.hpp"
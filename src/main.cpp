@@ -5,7 +5,7 @@
 #include <algorithm>
 #include <string>
 #include <vector>
-#include <unordered_set>
+#include <deque>
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -13,6 +13,12 @@
 #include "modules/Starter.hpp"
 #include "modules/Scene.hpp"
 #include "modules/TextMaker.hpp"
+#include "modules/LightClusters.hpp"
+#include "modules/LightmapBaker.hpp"
+#include "modules/ShadowMaps.hpp"
+#include "modules/MeshSimplifier.hpp"
+#include "modules/CellPortals.hpp"
+#include "modules/OcclusionCuller.hpp"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -22,6 +28,14 @@ struct VertexSimp {
     glm::vec2 UV;
 };
 
+// static geometry with baked lighting
+struct VertexLM {
+    glm::vec3 pos;
+    glm::vec3 norm;
+    glm::vec2 UV;
+    glm::vec2 UV2;  // lightmap chart, written by LightmapBaker
+};
+
 struct VertexOverlay {
     glm::vec2 pos;
     glm::vec2 UV;
@@ -37,15 +51,30 @@ struct GlobalUBO {
     alignas(4) glm::float32 numLights;
     alignas(16) glm::vec3 ambientLightColor;
     alignas(16) glm::vec3 eyePos;
+    // clustered lighting
+    alignas(16) glm::mat4 viewMat;
+    alignas(16) glm::vec4 screen;   // framebuffer width, height
+    alignas(16) glm::vec4 clusterZ; // depth slice = log(depth) * x + y
+    alignas(16) glm::mat4 viewPrj;  // projection * view: the only per frame transform
 };
 
 struct LocalUBO {
-    alignas(4) glm::float32 gamma;
-    alignas(16) glm::vec3 specularColor;
-    alignas(16) glm::mat4 mvpMat;
     alignas(16) glm::mat4 mMat;
     alignas(16) glm::mat4 nMat;
     alignas(16) glm::vec4 visibilityFlag;
+    alignas(16) glm::vec4 lightmapST;   // Lightmapped technique only
+};
+
+// constants of a material of the scene, written once (see writeStaticUBOs)
+struct MaterialUBO {
+    alignas(4) glm::float32 gamma;
+    alignas(16) glm::vec3 specularColor;
+};
+
+// a material in the table of the bindless set (see Lambert-Blinn-Bindless.frag)
+struct BindlessMaterial {
+    alignas(16) glm::vec4 specularGamma;    // specular color, exponent
+    alignas(16) glm::uvec4 textures;        // positions in Scene::T of the texture and the noise
 };
 
 struct OverlayUniformBuffer {
@@ -58,8 +87,7 @@ protected:
     bool tabPressed = false;
     int prevTabState = GLFW_RELEASE;
 
-    // Delete assets
-    std::unordered_set<std::string> hiddenIds;
+    // Delete assets (hidden, see Scene::setHidden)
     int prevDState = GLFW_RELEASE;
 
     // Mode switch state, false = Camera mode, true = Edit mode
@@ -74,16 +102,89 @@ protected:
     bool showList = true;
     int  prevLState = GLFW_RELEASE;
 
-    std::vector<int> selectableIndices;  // All instances
-    std::vector<std::string> selectableIds;  // Name of the assets
-    int  selectedObjectIndex = -1; // Index in scene.json
-    int  selectedListPos     = -1; // Index in selectableIndices
+    std::vector<int> selectable;   // Handles of the furniture that can be edited
+    int  selectedHandle  = -1;     // Handle of the selected instance
+    int  selectedListPos = -1;     // Index in selectable
 
     RenderPass RP;
-    DescriptorSetLayout DSLglobal, DSLmesh, DSLoverlay;
-
-    VertexDescriptor VDsimp, VDoverlay;
-    Pipeline PMesh, POverlay;
+    DescriptorSetLayout DSLglobal, DSLlocal, DSLmat, DSLmatLM, DSLoverlay;
+    DescriptorSet DSglobal;     // shared by all the instances
+
+    // Bindless textures: where the device has descriptor indexing, the "Mesh" and "Unlit"
+    // techniques read all the textures of the scene from one array, and the constants from
+    // a table of all the materials, in one set (DSbindless) bound once per technique; each
+    // draw pushes the index of its material. Otherwise (or with USE_BINDLESS false) they
+    // have a set per material, like the "Lightmapped" technique always does
+    static const bool USE_BINDLESS = true;
+    bool bindless = false;
+    int bindlessTextures = 0;   // textures of scene.json, known before the pipelines are made
+    DescriptorSetLayout DSLbindless;
+    DescriptorSet DSbindless;
+    VkSampler bindlessSampler = VK_NULL_HANDLE;   // the one of all the scene textures, in the layout
+
+    // Point lights, binned every frame in view space clusters
+    LightClusters LC;
+
+    // Diffuse light of the static geometry ("Lightmapped" technique), baked at startup
+    LightmapBaker LMB;
+    Texture TLM;
+    int lmTI = -1;      // technique instances of SC using the lightmap
+
+    // Point light shadows, rendered again only when an instance near a light moves
+    ShadowMaps SM;
+
+    // Levels of detail of the furniture, chosen every frame by screen size (O toggles them)
+    MeshSimplifier MS;
+    int prevOState = GLFW_RELEASE;
+    int shownTriangles = -1;
+
+    // Rooms and doors of scene.json: only what is visible through the doors is drawn (C toggles)
+    CellPortals CP;
+    int prevCState = GLFW_RELEASE;
+    std::string shownPortals;
+
+    // Furniture hidden by the walls, rasterized on the CPU every frame (X toggles)
+    OcclusionCuller OC;
+    int prevXState = GLFW_RELEASE;
+    int occFrames = 0;
+    std::string shownOcclusion;
+
+    // K switches the scene descriptor sets between bulk and one by one creation, and
+    // recreates the swap chain: the time of both is printed
+    int prevKState = GLFW_RELEASE;
+
+    // Instances added at run time: N duplicates the selected one, M runs the stress test
+    // (STRESS_BATCH copies added every frame for STRESS_FRAMES frames, the oldest removed
+    // beyond STRESS_LIVE, then all of them removed)
+    static const int STRESS_FRAMES = 40;
+    static const int STRESS_BATCH = 250;
+    static const int STRESS_LIVE = 4000;
+    int prevNState = GLFW_RELEASE;
+    int prevMState = GLFW_RELEASE;
+    int stressFrame = -1;
+    std::deque<int> stressHandles;
+    double stressAddUs = 0.0, stressRemoveUs = 0.0;
+    int stressAdded = 0, stressRemoved = 0;
+
+    // Depth pre-pass: the scene has four passes, 0 = depth only, 1 = shading with an
+    // EQUAL depth test, 2 = classic single pass shading, 3 = single pass with the
+    // 32 bit float shaders (2 and 3 are used for comparisons)
+    enum RenderMode {PREPASS, SINGLE_PASS, SINGLE_PASS_FP32, RENDER_MODES};
+    int renderMode = PREPASS;
+    GPUTimer gpuTimer;
+
+    // Benchmark (B): BENCH_FRAMES frames in each of the render modes
+    const int BENCH_FRAMES = 300;
+    const int BENCH_WARMUP = 10;    // frames skipped after every mode switch
+    int benchFrame = -1;
+    double benchTime[RENDER_MODES];
+    int benchCount[RENDER_MODES];
+    int prevBState = GLFW_RELEASE;
+
+    VertexDescriptor VDsimp, VDpos, VDlm, VDposLM, VDoverlay;
+    // shading pipelines use the fp16 shaders when the device supports them,
+    // PMesh32 and PLm32 always use the fp32 ones
+    Pipeline PMesh, PMeshEq, PDepth, PLm, PLmEq, PDepthLM, PMesh32, PLm32, POverlay;
 
     OverlayUniformBuffer KeyUBO{};
     DescriptorSet DSKey;
@@ -129,6 +230,7 @@ protected:
     void onWindowResize(int w, int h) override {
         std::cout << "Window resized to: " << w << " x " << h << "\n";
         if (h > 0) Ar = float(w) / float(h);
+        LC.setProjection(glm::radians(60.0f), Ar, 1.0f, 270.0f);
         RP.width  = w;
         RP.height = h;
 
@@ -139,19 +241,44 @@ protected:
         // set = 0 (global)
         DSLglobal.init(this, {
             { 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_ALL_GRAPHICS,
-                sizeof(GlobalUBO), 1}
+                sizeof(GlobalUBO), 1},
+            { 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
+                sizeof(ClusterLight) * MAX_CLUSTER_LIGHTS, 1},
+            { 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
+                sizeof(ClusterRange) * CLUSTER_COUNT, 1},
+            { 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
+                sizeof(uint32_t) * MAX_CLUSTER_LIGHT_INDICES, 1},
+            { 4, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT,
+                0, 1}   // shadow cube maps
         });
 
         // set = 1 (local)
-        DSLmesh.init(this, {
+        DSLlocal.init(this, {
             { 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_ALL_GRAPHICS,
-            sizeof(LocalUBO), 1 },
+            sizeof(LocalUBO), 1 }
+        });
+
+        // set = 2 (material), one per material of the scene
+        DSLmat.init(this, {
+            { 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
+            sizeof(MaterialUBO), 1 },
             { 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT,
             0, 1 },
             { 2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT,
             1, 1 }
         });
 
+        DSLmatLM.init(this, {
+            { 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
+            sizeof(MaterialUBO), 1 },
+            { 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT,
+            0, 1 },
+            { 2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT,
+            1, 1 },
+            { 3, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT,
+            2, 1 }
+        });
+
         DSLoverlay.init(this, {
             {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_ALL_GRAPHICS,
                 sizeof(OverlayUniformBuffer), 1},
@@ -167,6 +294,28 @@ protected:
             {0, 2, VK_FORMAT_R32G32_SFLOAT,    offsetof(VertexSimp,UV),   sizeof(glm::vec2), UV}
         });
 
+        // position only view of the same vertex buffers, for the depth pre-pass
+        VDpos.init(this,
+        { {0, sizeof(VertexSimp), VK_VERTEX_INPUT_RATE_VERTEX} },
+        {
+            {0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(VertexSimp,pos),  sizeof(glm::vec3), POSITION}
+        });
+
+        VDlm.init(this,
+        { {0, sizeof(VertexLM), VK_VERTEX_INPUT_RATE_VERTEX} },
+        {
+            {0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(VertexLM,pos),  sizeof(glm::vec3), POSITION},
+            {0, 1, VK_FORMAT_R32G32B32_SFLOAT, offsetof(VertexLM,norm), sizeof(glm::vec3), NORMAL},
+            {0, 2, VK_FORMAT_R32G32_SFLOAT,    offsetof(VertexLM,UV),   sizeof(glm::vec2), UV},
+            {0, 3, VK_FORMAT_R32G32_SFLOAT,    offsetof(VertexLM,UV2),  sizeof(glm::vec2), OTHER}
+        });
+
+        VDposLM.init(this,
+        { {0, sizeof(VertexLM), VK_VERTEX_INPUT_RATE_VERTEX} },
+        {
+            {0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(VertexLM,pos),  sizeof(glm::vec3), POSITION}
+        });
+
         VDoverlay.init(this,
         { {0, sizeof(VertexOverlay), VK_VERTEX_INPUT_RATE_VERTEX} },
             {
@@ -177,12 +326,106 @@ protected:
         RP.init(this);
         RP.properties[0].clearValue = {0.05f, 0.05f, 0.08f, 1.0f};
 
+        // the light count bounds the per-cluster loop of the shaders
+        LC.init(glm::radians(60.0f), Ar, 1.0f, 270.0f);
+        buildLightsFromJSON("assets/models/scene.json");
+        uint32_t numLights = LC.lights.size();
+        uint32_t shadowLights = std::min((int)numLights, SHADOW_MAX_LIGHTS);
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        // the array holds every texture of the scene, read from the file before it is loaded
+        bindlessTextures = textureCountFromJSON("assets/models/scene.json");
+        uint32_t maxTextures = std::min({properties.limits.maxPerStageDescriptorSamplers,
+                                         properties.limits.maxPerStageDescriptorSampledImages,
+                                         properties.limits.maxDescriptorSetSampledImages});
+        bindless = USE_BINDLESS && descriptorIndexing && ((uint32_t)bindlessTextures <= maxTextures);
+        std::cout << "Mesh textures: " << (bindless ? "bindless" : "one descriptor set per material");
+        if (USE_BINDLESS && descriptorIndexing && !bindless) {
+            std::cout << " (" << bindlessTextures << " textures, the device allows " << maxTextures << ")";
+        }
+        std::cout << "\n";
+
+        // set 2, push constants and fragment shaders of the mesh pipelines
+        DescriptorSetLayout *DSLmeshMat = bindless ? &DSLbindless : &DSLmat;
+        std::vector<VkPushConstantRange> meshPK;
+        if (bindless) meshPK.push_back({VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(uint32_t)});
+        std::string meshFrag = bindless ? "shaders/Lambert-Blinn-Bindless" : "shaders/Lambert-Blinn-Clustered";
+
         PMesh.init(this, &VDsimp,
             "shaders/Mesh.vert.spv",
-            "shaders/Lambert-Blinn.frag.spv",
-            {&DSLglobal, &DSLmesh});
+            meshFrag + ".frag.spv",
+            {&DSLglobal, &DSLlocal, DSLmeshMat}, meshPK);
         PMesh.setCullMode(VK_CULL_MODE_NONE);
         PMesh.setCompareOp(VK_COMPARE_OP_LESS_OR_EQUAL);
+        PMesh.setSpecialization(VK_SHADER_STAGE_FRAGMENT_BIT, 0, numLights);
+        PMesh.setSpecialization(VK_SHADER_STAGE_FRAGMENT_BIT, 2, shadowLights);
+        PMesh.setHalfPrecisionShader(meshFrag + "16.frag.spv");
+
+        PMesh32.init(this, &VDsimp,
+            "shaders/Mesh.vert.spv",
+            meshFrag + ".frag.spv",
+            {&DSLglobal, &DSLlocal, DSLmeshMat}, meshPK);
+        PMesh32.setCullMode(VK_CULL_MODE_NONE);
+        PMesh32.setCompareOp(VK_COMPARE_OP_LESS_OR_EQUAL);
+        PMesh32.setSpecialization(VK_SHADER_STAGE_FRAGMENT_BIT, 0, numLights);
+        PMesh32.setSpecialization(VK_SHADER_STAGE_FRAGMENT_BIT, 2, shadowLights);
+
+        PDepth.init(this, &VDpos,
+            "shaders/MeshDepth.vert.spv",
+            "shaders/MeshDepth.frag.spv",
+            {&DSLglobal, &DSLlocal, DSLmeshMat}, meshPK);
+        PDepth.setCullMode(VK_CULL_MODE_NONE);
+        PDepth.setColorWrite(false);
+
+        // after the pre-pass only the visible fragment of each pixel passes
+        PMeshEq.init(this, &VDsimp,
+            "shaders/Mesh.vert.spv",
+            meshFrag + ".frag.spv",
+            {&DSLglobal, &DSLlocal, DSLmeshMat}, meshPK);
+        PMeshEq.setCullMode(VK_CULL_MODE_NONE);
+        PMeshEq.setCompareOp(VK_COMPARE_OP_EQUAL);
+        PMeshEq.setDepthWrite(false);
+        PMeshEq.setSpecialization(VK_SHADER_STAGE_FRAGMENT_BIT, 0, numLights);
+        PMeshEq.setSpecialization(VK_SHADER_STAGE_FRAGMENT_BIT, 2, shadowLights);
+        PMeshEq.setHalfPrecisionShader(meshFrag + "16.frag.spv");
+
+        PDepthLM.init(this, &VDposLM,
+            "shaders/MeshDepth.vert.spv",
+            "shaders/MeshDepth.frag.spv",
+            {&DSLglobal, &DSLlocal, &DSLmatLM});
+        PDepthLM.setCullMode(VK_CULL_MODE_NONE);
+        PDepthLM.setColorWrite(false);
+
+        PLmEq.init(this, &VDlm,
+            "shaders/MeshLM.vert.spv",
+            "shaders/Lightmapped.frag.spv",
+            {&DSLglobal, &DSLlocal, &DSLmatLM});
+        PLmEq.setCullMode(VK_CULL_MODE_NONE);
+        PLmEq.setCompareOp(VK_COMPARE_OP_EQUAL);
+        PLmEq.setDepthWrite(false);
+        PLmEq.setSpecialization(VK_SHADER_STAGE_FRAGMENT_BIT, 0, numLights);
+        PLmEq.setSpecialization(VK_SHADER_STAGE_FRAGMENT_BIT, 2, shadowLights);
+        PLmEq.setHalfPrecisionShader("shaders/Lightmapped16.frag.spv");
+
+        PLm.init(this, &VDlm,
+            "shaders/MeshLM.vert.spv",
+            "shaders/Lightmapped.frag.spv",
+            {&DSLglobal, &DSLlocal, &DSLmatLM});
+        PLm.setCullMode(VK_CULL_MODE_NONE);
+        PLm.setCompareOp(VK_COMPARE_OP_LESS_OR_EQUAL);
+        PLm.setSpecialization(VK_SHADER_STAGE_FRAGMENT_BIT, 0, numLights);
+        PLm.setSpecialization(VK_SHADER_STAGE_FRAGMENT_BIT, 2, shadowLights);
+        PLm.setHalfPrecisionShader("shaders/Lightmapped16.frag.spv");
+
+        PLm32.init(this, &VDlm,
+            "shaders/MeshLM.vert.spv",
+            "shaders/Lightmapped.frag.spv",
+            {&DSLglobal, &DSLlocal, &DSLmatLM});
+        PLm32.setCullMode(VK_CULL_MODE_NONE);
+        PLm32.setCompareOp(VK_COMPARE_OP_LESS_OR_EQUAL);
+        PLm32.setSpecialization(VK_SHADER_STAGE_FRAGMENT_BIT, 0, numLights);
+        PLm32.setSpecialization(VK_SHADER_STAGE_FRAGMENT_BIT, 2, shadowLights);
 
         POverlay.init(this, &VDoverlay,
             "shaders/Overlay.vert.spv",
@@ -190,25 +433,60 @@ protected:
             {&DSLoverlay});
         POverlay.setCullMode(VK_CULL_MODE_NONE);
 
-        VDRs.resize(1);
+        VDRs.resize(2);
         VDRs[0].init("VDsimp", &VDsimp);
-
-        PRs.resize(1);
+        VDRs[1].init("VDlm", &VDlm);
+
+        PRs.resize(3);
+        // same sets in all the passes: one local set per instance, and one material
+        // set shared by the instances of each material
+        std::vector<std::vector<TextureDefs>> meshTex = {
+            {},
+            {},
+            {
+                { true, 0, {} },
+                { true, 1, {} },
+            }
+        };
         PRs[0].init("Mesh", {
-          {&PMesh, {
-              {},
+          {&PDepth, meshTex},
+          {&PMeshEq, meshTex},
+          {&PMesh, meshTex},
+          {&PMesh32, meshTex}
+        }, 2, &VDsimp, bindless ? -1 : 2);
+
+        // the lightmap view is set once it has been baked, after the scene is loaded
+        std::vector<std::vector<TextureDefs>> lmTex = {
+            {},
+            {},
             {
                 { true, 0, {} },
                 { true, 1, {} },
-                }
+                { false, 0, {} },
             }
-          }
-        }, 2, &VDsimp);
-
-        // Pool sizing
-        DPSZs.uniformBlocksInPool = 4;
-        DPSZs.texturesInPool      = 30;
-        DPSZs.setsInPool          = 3;
+        };
+        PRs[1].init("Lightmapped", {
+          {&PDepthLM, lmTex},
+          {&PLmEq, lmTex},
+          {&PLm, lmTex},
+          {&PLm32, lmTex}
+        }, 2, &VDlm, 2);
+
+        // props that need no lighting: variants of the mesh pipelines without
+        // point lights and noise (the second texture is not sampled)
+        std::vector<SpecializationValue> unlit = {
+            {VK_SHADER_STAGE_FRAGMENT_BIT, 0, 0},
+            {VK_SHADER_STAGE_FRAGMENT_BIT, 1, VK_FALSE}
+        };
+        PRs[2].init("Unlit", {
+          {&PDepth, meshTex},
+          {PMeshEq.variant(unlit), meshTex},
+          {PMesh.variant(unlit), meshTex},
+          {PMesh32.variant(unlit), meshTex}
+        }, 2, &VDsimp, bindless ? -1 : 2);
+        if (bindless) {
+            PRs[0].materialPush = PRs[2].materialPush = VK_SHADER_STAGE_FRAGMENT_BIT;
+        }
 
         MKey.vertices = std::vector<unsigned char>(4 * sizeof(VertexOverlay));
         VertexOverlay *V2 = (VertexOverlay *)(&(MKey.vertices[0]));
@@ -224,9 +502,42 @@ protected:
         TKey.init(this, "assets/textures/Keyboard.png");
 
         std::cout << "\nLoading the scene\n\n";
-        SC.init(this, 1, VDRs, PRs, "assets/models/scene.json");
-        buildSelectableFromJSON("assets/models/scene.json");
+        SC.shareDescriptorSet(&DSLglobal, &DSglobal);
+        if (bindless) SC.shareDescriptorSet(&DSLbindless, &DSbindless);
+        SC.init(this, 4, VDRs, PRs, "assets/models/scene.json");
+        if (bindless) {
+            if (SC.TextureCount != bindlessTextures) {
+                throw std::runtime_error("the bindless array was sized for a different number of textures");
+            }
+            // sized now that the scene is loaded, the pipelines are created later
+            bindlessSampler = getSampler(Texture::samplerCreateInfo());
+            DSLbindless.init(this, {
+                { 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
+                (int)(sizeof(BindlessMaterial) * std::max((int)SC.Mat.size(), 1)), 1 },
+                { 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT,
+                0, SC.TextureCount, bindlessSampler }
+            });
+        }
+        buildSelectable();
+        buildCellsFromJSON("assets/models/scene.json");
+        bakeLightmap();
+        // the lightmapped models are not simplified: their charts are per triangle
+        MS.generateLODs(this, &SC, {&PRs[0], &PRs[2]});
+        // floor, walls, doors and windows: one draw call per texture
+        SC.buildStaticBatches(staticVerticesAccess, this);
+        OC.init(&SC);
+
+        std::vector<glm::vec4> lightPosRadius;
+        for (auto &l : LC.lights) {
+            lightPosRadius.push_back(l.posRadius);
+        }
+        SM.init(this, &SC, lightPosRadius);
+        SM.addTechnique(&PRs[0], &VDpos);
+        SM.addTechnique(&PRs[1], &VDposLM);
+        SM.addTechnique(&PRs[2], &VDpos);
 
+        txt.setSDF(true);          // distance field font, one 12-byte instance per glyph, single draw
+        txt.setHostPass(&RP, "main", 0, populateCommandBufferAccess, this);    // text drawn at the end of RP
         txt.init(this, windowWidth, windowHeight);
 
         txt.print(-0.95f, -0.95f, ("CAM MODE"), 1, "SS");
@@ -243,22 +554,50 @@ protected:
     void pipelinesAndDescriptorSetsInit() override {
         RP.create();
         PMesh.create(&RP);
+        PMeshEq.create(&RP);
+        PDepth.create(&RP);
+        PLm.create(&RP);
+        PLmEq.create(&RP);
+        PDepthLM.create(&RP);
+        PMesh32.create(&RP);
+        PLm32.create(&RP);
         POverlay.create(&RP);
+        SM.create();
+        gpuTimer.init(this);
 
         DSKey.init(this, &DSLoverlay, {TKey.getViewAndSampler()});
+        DSglobal.init(this, &DSLglobal, {SM.getViewAndSampler()});
+        if (bindless) {
+            std::vector<VkDescriptorImageInfo> textures;
+            for (int t = 0; t < SC.TextureCount; t++) {
+                textures.push_back(SC.T[t]->getViewAndSampler());
+            }
+            DSbindless.init(this, &DSLbindless, textures);
+        }
 
         SC.pipelinesAndDescriptorSetsInit();
+        writeStaticUBOs();
         txt.pipelinesAndDescriptorSetsInit();
 
+        // the text maker shares RP: it submits the "main" command buffer for us
         txt.updateCommandBuffer();
-
-        submitCommandBuffer("main", 0, populateCommandBufferAccess, this);
     }
 
     void pipelinesAndDescriptorSetsCleanup() override {
         PMesh.cleanup();
+        PMeshEq.cleanup();
+        PDepth.cleanup();
+        PLm.cleanup();
+        PLmEq.cleanup();
+        PDepthLM.cleanup();
+        PMesh32.cleanup();
+        PLm32.cleanup();
         POverlay.cleanup();
+        SM.cleanup();
+        gpuTimer.cleanup();
         DSKey.cleanup();
+        DSglobal.cleanup();
+        if (bindless) DSbindless.cleanup();
         RP.cleanup();
 
         SC.pipelinesAndDescriptorSetsCleanup();
@@ -271,9 +610,25 @@ protected:
         DSLoverlay.cleanup();
 
         DSLglobal.cleanup();
-        DSLmesh.cleanup();
+        DSLlocal.cleanup();
+        DSLmat.cleanup();
+        DSLmatLM.cleanup();
+        if (bindless) {
+            DSLbindless.cleanup();
+            releaseSampler(bindlessSampler);
+        }
+        if (lmTI >= 0) TLM.cleanup();
         PMesh.destroy();
+        PMeshEq.destroy();
+        PDepth.destroy();
+        PLm.destroy();
+        PLmEq.destroy();
+        PDepthLM.destroy();
+        PMesh32.destroy();
+        PLm32.destroy();
         POverlay.destroy();
+        SM.destroy();
+        OC.destroy();
         RP.destroy();
 
         SC.localCleanup();
@@ -285,10 +640,66 @@ protected:
         app->populateCommandBuffer(commandBuffer, currentImage);
     }
 
+    // Lightmap UVs of the instances merged in a static batch: their atlas region
+    // is applied to the vertices, the batch has a single one
+    static void staticVerticesAccess(Instance *I, unsigned char *vertices, int count, void *params) {
+        CG_hospital *app = (CG_hospital*)params;
+        if ((app->lmTI < 0) || (I->TIp != &app->SC.TI[app->lmTI])) return;
+
+        glm::vec4 ST = app->LMB.ST[I - app->SC.TI[app->lmTI].I];
+        VertexLM *V = (VertexLM *)vertices;
+        for (int v = 0; v < count; v++) {
+            V[v].UV2 = V[v].UV2 * glm::vec2(ST.x, ST.y) + glm::vec2(ST.z, ST.w);
+        }
+    }
+
+    // The batches are already in world space and the view-projection is in the global
+    // set: their uniforms never change, they are written for all the images at once.
+    // So are the constants of the materials
+    void writeStaticUBOs() {
+        if (bindless) {
+            std::vector<BindlessMaterial> table(std::max((int)SC.Mat.size(), 1));
+            for (int m = 0; m < SC.Mat.size(); m++) {
+                table[m].specularGamma = glm::vec4(SC.Mat[m]->specularColor, SC.Mat[m]->gamma);
+                table[m].textures = glm::uvec4(SC.Mat[m]->Tid[0], SC.Mat[m]->Tid[1], 0, 0);
+            }
+            for (int i = 0; i < swapChainImages.size(); i++) {
+                DSbindless.map(i, table.data(), 0);
+            }
+        }
+        for (Material *m : SC.Mat) {
+            if (m->DS[0] == nullptr) continue;     // bindless
+            MaterialUBO u{};
+            u.gamma = m->gamma;
+            u.specularColor = m->specularColor;
+            for (int i = 0; i < swapChainImages.size(); i++) {
+                m->DS[0]->map(i, &u, 0);   // shared by the passes
+            }
+        }
+        for (StaticBatch *B : SC.batches) {
+            LocalUBO l{};
+            l.mMat = glm::mat4(1.0f);
+            l.nMat = glm::mat4(1.0f);
+            l.visibilityFlag = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+            l.lightmapST = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f);
+            for (int i = 0; i < swapChainImages.size(); i++) {
+                B->leader->DS[0][1]->map(i, &l, 0);
+            }
+        }
+    }
+
     void populateCommandBuffer(VkCommandBuffer cmdBuffer, int currentImage) {
+        gpuTimer.begin(cmdBuffer, currentImage);
         RP.begin(cmdBuffer, currentImage);
 
-        SC.populateCommandBuffer(cmdBuffer, 0, currentImage);
+        if (renderMode == PREPASS) {
+            SC.populateCommandBuffer(cmdBuffer, 0, currentImage);   // depth only
+            SC.populateCommandBuffer(cmdBuffer, 1, currentImage);   // shading, EQUAL
+        } else if (renderMode == SINGLE_PASS) {
+            SC.populateCommandBuffer(cmdBuffer, 2, currentImage);   // shading, LESS_OR_EQUAL
+        } else {
+            SC.populateCommandBuffer(cmdBuffer, 3, currentImage);   // same, fp32 shaders
+        }
 
         POverlay.bind(cmdBuffer);
         DSKey.bind(cmdBuffer, POverlay, 0, currentImage);
@@ -296,7 +707,10 @@ protected:
         vkCmdDrawIndexed(cmdBuffer,static_cast<uint32_t>(MKey.indices.size()), 1,
                         0, 0, 0);
 
+        txt.draw(cmdBuffer, currentImage);
+
         RP.end(cmdBuffer);
+        gpuTimer.end(cmdBuffer, currentImage);
     }
 
     void updateUniformBuffer(uint32_t currentImage) {
@@ -309,16 +723,26 @@ protected:
 
         getSixAxis(dt, m, r, fire);
         glm::mat4 View = updateFromInput(dt, m, r, fire);
+        SC.updateTransforms();   // the edited instance and its children
+        SC.recycle();
 
         handleObjectSelection();
         handleKeyboardOverlay();
         handleModeToggle();
         handleDelete();
+        handleSpawn();
         handleListDisplay();
+        handleBenchmark(currentImage);
+        handleDescriptorSetMode();
+        SM.update();    // usually nothing to do, the maps are cached
 
         glm::mat4 Prj = glm::perspective(glm::radians(60.0f), Ar, 0.01f, 270.0f);
         Prj[1][1] *= -1.0f;
 
+        handleVisibility(Prj * View);
+        handleOcclusion(Prj * View);
+        handleLOD();
+
         GlobalUBO g{};
         for (int i = 0; i < N_POINTLIGHTS; i++) {
             g.lightPos[i] = LightPos[i];
@@ -330,33 +754,46 @@ protected:
         g.ambientLightColor = glm::vec3(0.2f, 0.19f, 0.18f);
         g.eyePos = camPos;
 
-        for (int i = 0; i < SC.TI[0].InstanceCount; ++i) {
-            auto &inst = SC.TI[0].I[i];
+        LC.build(View);
+        g.viewMat = View;
+        g.screen = glm::vec4(RP.width, RP.height, 0.0f, 0.0f);
+        g.clusterZ = LC.zParams();
+        g.viewPrj = Prj * View;
+
+        DSglobal.map(currentImage, &g, 0);
+        DSglobal.map(currentImage, LC.lights.data(), 1, LC.lights.size() * sizeof(ClusterLight));
+        DSglobal.map(currentImage, LC.grid.data(), 2);
+        DSglobal.map(currentImage, LC.indices.data(), 3, LC.indicesCount * sizeof(uint32_t));
+
+        for (int h = 0; h < SC.HandleCount; ++h) {
+            auto &inst = *SC.I[h];
+            if (inst.TIp == nullptr) continue;     // removed
+            if (inst.batch != nullptr) continue;   // see writeStaticUBOs()
+            // only the instances moved or hidden since this image was last written
+            if (!SC.takeDirty(&inst, currentImage)) continue;
 
             LocalUBO l{};
-            l.gamma = 120.0f;
-            l.specularColor = glm::vec3(1.0f, 0.95f, 0.9f);
             l.mMat = inst.Wm;
-            l.nMat = glm::inverse(glm::transpose(l.mMat));
-            l.mvpMat = Prj * View * l.mMat;
-
-            const std::string& instances = *inst.id;
-            float visible = (hiddenIds.count(instances) ? 0.0f : 1.0f);
+            l.nMat = SC.normalMatrix(&inst);
 
             l.visibilityFlag = glm::vec4(
+                SC.isSelected(inst.Iid) ? 1.0f : 0.0f,
                 0.0f,
                 0.0f,
-                0.0f,
-                visible
+                SC.isHidden(inst.Iid) ? 0.0f : 1.0f
             );
+            if ((lmTI >= 0) && (inst.TIp == &SC.TI[lmTI])) {
+                l.lightmapST = LMB.ST[&inst - SC.TI[lmTI].I];
+            }
 
-            inst.DS[0][0]->map(currentImage, &g, 0);  // global
-            inst.DS[0][1]->map(currentImage, &l, 0);  // local
+            inst.DS[0][1]->map(currentImage, &l, 0);  // local, shared by the three passes
         }
 
         KeyUBO.visible = showKeyOverlay ? 1.0f : 0.0f;
         DSKey.map(currentImage, &KeyUBO, 0);
 
+        txt.updateUniformBuffer(currentImage);
+
     }
 
     glm::mat4 updateFromInput(float dt, const glm::vec3& m, const glm::vec3& r, bool fire) {
@@ -388,47 +825,47 @@ protected:
             return View;
         } else {
             // EDIT MODE for instances
-            if (selectedObjectIndex < 0) {
+            if (selectedHandle < 0) {
                 return glm::lookAt(camPos, camPos + camFwd, glm::vec3(0,1,0));
             };
 
-            auto &inst = SC.TI[0].I[selectedObjectIndex];
+            auto &inst = *SC.I[selectedHandle];
 
             // TRANSLATE
             if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS) {
-                inst.Wm = glm::translate(glm::mat4(1), glm::vec3(-MOVE_SPEED*dt, 0, 0)) * inst.Wm;
+                SC.moveBy(&inst, glm::vec3(-MOVE_SPEED*dt, 0, 0));
             }
             if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS) {
-                inst.Wm = glm::translate(glm::mat4(1), glm::vec3(MOVE_SPEED*dt, 0, 0)) * inst.Wm;
+                SC.moveBy(&inst, glm::vec3(MOVE_SPEED*dt, 0, 0));
             }
             if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS) {
-                inst.Wm = glm::translate(glm::mat4(1), glm::vec3(0, 0, -MOVE_SPEED*dt)) * inst.Wm;
+                SC.moveBy(&inst, glm::vec3(0, 0, -MOVE_SPEED*dt));
             }
             if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS) {
-                inst.Wm = glm::translate(glm::mat4(1), glm::vec3(0, 0, MOVE_SPEED*dt)) * inst.Wm;
+                SC.moveBy(&inst, glm::vec3(0, 0, MOVE_SPEED*dt));
             }
             if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS) {
-                inst.Wm = glm::translate(glm::mat4(1), glm::vec3(0, MOVE_SPEED*dt, 0)) * inst.Wm;
+                SC.moveBy(&inst, glm::vec3(0, MOVE_SPEED*dt, 0));
             }
             if (glfwGetKey(window, GLFW_KEY_F) == GLFW_PRESS) {
-                inst.Wm = glm::translate(glm::mat4(1), glm::vec3(0, -MOVE_SPEED*dt, 0)) * inst.Wm;
+                SC.moveBy(&inst, glm::vec3(0, -MOVE_SPEED*dt, 0));
             }
 
             // ROTATE about Y-axis
             if (glfwGetKey(window, GLFW_KEY_T) == GLFW_PRESS) {
-                inst.Wm = inst.Wm * glm::rotate(glm::mat4(1), ROT_SPEED*dt, glm::vec3(0,1,0));
+                SC.setLocal(&inst, inst.pos, inst.rot * glm::angleAxis(ROT_SPEED*dt, glm::vec3(0,1,0)), inst.scl);
             }
             if (glfwGetKey(window, GLFW_KEY_G) == GLFW_PRESS) {
-                inst.Wm = inst.Wm * glm::rotate(glm::mat4(1), -ROT_SPEED*dt, glm::vec3(0,1,0));
+                SC.setLocal(&inst, inst.pos, inst.rot * glm::angleAxis(-ROT_SPEED*dt, glm::vec3(0,1,0)), inst.scl);
             }
 
             // SCALE
             if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) { // grow
-                inst.Wm = inst.Wm * glm::scale(glm::mat4(1.0f), glm::vec3(step));
+                SC.setLocal(&inst, inst.pos, inst.rot, inst.scl * step);
             }
 
             if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) { // shrink
-                inst.Wm = inst.Wm * glm::scale(glm::mat4(1.0f), glm::vec3(1.0f / step));
+                SC.setLocal(&inst, inst.pos, inst.rot, inst.scl / step);
             }
 
             glm::vec3 objectPos = glm::vec3(inst.Wm * glm::vec4(0, 0, 0, 1));
@@ -453,26 +890,192 @@ protected:
         prevPState = pState;
     }
 
+    void setRenderMode(int mode) {
+        renderMode = mode;
+        txt.invalidate();           // "main" is recorded by the text maker
+        txt.updateCommandBuffer();
+    }
+
+    // Levels of the instances for the current camera: the draw calls change only when
+    // an instance crosses a threshold
+    void handleLOD() {
+        int oState = glfwGetKey(window, GLFW_KEY_O);
+        bool toggled = (oState == GLFW_PRESS && prevOState == GLFW_RELEASE);
+        prevOState = oState;
+        if (toggled) {
+            SC.useLODs = !SC.useLODs;
+        }
+
+        float pixelScale = 0.5f * RP.height / tan(glm::radians(30.0f));
+        bool changed = SC.updateLODs(camPos, pixelScale);
+        if (changed || toggled || SC.trianglesDrawn != shownTriangles) {
+            shownTriangles = SC.trianglesDrawn;
+            std::string s = "Triangles: " + std::to_string(SC.trianglesDrawn) +
+                            (SC.useLODs ? " (without LODs: " + std::to_string(SC.trianglesFull) + ")" : " (LOD off)");
+            txt.print(0.95f, -0.95f, s, 5, "SS", false, true, true, TAL_RIGHT, TRH_RIGHT, TRV_TOP);
+            txt.invalidate();
+        }
+        txt.updateCommandBuffer();
+    }
+
+    // Portal culling from the current camera, before handleLOD() that records the
+    // command buffer again if needed
+    void handleVisibility(const glm::mat4 &ViewPrj) {
+        int cState = glfwGetKey(window, GLFW_KEY_C);
+        bool toggled = (cState == GLFW_PRESS && prevCState == GLFW_RELEASE);
+        prevCState = cState;
+        if (toggled) {
+            CP.enabled = !CP.enabled;
+        }
+
+        if (CP.update(camPos, ViewPrj)) {
+            txt.invalidate();
+        }
+
+        std::string s;
+        if (!CP.enabled) {
+            s = "Portal culling off";
+        } else if (CP.cameraCell < 0) {
+            s = "Outside the cells";
+        } else {
+            s = CP.cells[CP.cameraCell].id + " - cells: " + std::to_string(CP.visitedCells) +
+                ", portals: " + std::to_string(CP.visitedPortals) +
+                ", culled: " + std::to_string(CP.culledInstances);
+        }
+        if (s != shownPortals) {
+            shownPortals = s;
+            txt.print(0.95f, -0.88f, s, 6, "SS", false, true, true, TAL_RIGHT, TRH_RIGHT, TRV_TOP);
+        }
+    }
+
+    // Occlusion culling, after the portals: the overlay is printed again only when the counts change,
+    // the timings go to the console once a second
+    void handleOcclusion(const glm::mat4 &ViewPrj) {
+        int xState = glfwGetKey(window, GLFW_KEY_X);
+        bool toggled = (xState == GLFW_PRESS && prevXState == GLFW_RELEASE);
+        prevXState = xState;
+        if (toggled) {
+            OC.enabled = !OC.enabled;
+        }
+
+        bool changed = OC.update(ViewPrj);
+        if (changed) {
+            txt.invalidate();
+        }
+
+        std::string s = OC.enabled ? "Occluded: " + std::to_string(OC.occludedCount) + "/" +
+                                     std::to_string(OC.occludees) + " - occluders: " +
+                                     std::to_string(OC.occluderTriangles) + " tris"
+                                   : "Occlusion culling off";
+        if (s != shownOcclusion) {
+            shownOcclusion = s;
+            txt.print(0.95f, -0.81f, s, 7, "SS", false, true, true, TAL_RIGHT, TRH_RIGHT, TRV_TOP);
+        }
+
+        if (OC.enabled && (++occFrames >= 60)) {
+            occFrames = 0;
+            std::ostringstream t;
+            t.precision(2);
+            t << std::fixed << "Occlusion: occluders " << OC.occluderMs << " ms, occludees " << OC.occludeeMs << " ms\n";
+            std::cout << t.str();
+        }
+    }
+
+    void handleDescriptorSetMode() {
+        int kState = glfwGetKey(window, GLFW_KEY_K);
+        if (kState == GLFW_PRESS && prevKState == GLFW_RELEASE) {
+            SC.bulkDescriptorSets = !SC.bulkDescriptorSets;
+            std::cout << "Last swap chain: " << SC.descriptorSetsCreated << " descriptor sets in " <<
+                         SC.descriptorSetsMs << " ms, now " << (SC.bulkDescriptorSets ? "bulk" : "one by one") << "\n";
+            RebuildPipeline();
+        }
+        prevKState = kState;
+    }
+
+    // GPU time of the frame in each render mode: the pre-pass against the single pass
+    // and the fp16 shaders against the fp32 ones
+    void handleBenchmark(uint32_t currentImage) {
+        int bState = glfwGetKey(window, GLFW_KEY_B);
+
+        if (bState == GLFW_PRESS && prevBState == GLFW_RELEASE && benchFrame < 0) {
+            std::cout << "Benchmark: " << BENCH_FRAMES << " frames per mode\n";
+            benchFrame = 0;
+            for (int i = 0; i < RENDER_MODES; i++) {
+                benchTime[i] = 0.0;
+                benchCount[i] = 0;
+            }
+            setRenderMode(PREPASS);
+        }
+        prevBState = bState;
+
+        if (benchFrame < 0) return;
+
+        // the timer of this image holds its previous submission
+        int mode = benchFrame / BENCH_FRAMES;
+        double ms;
+        if (benchFrame % BENCH_FRAMES >= BENCH_WARMUP && gpuTimer.read(currentImage, ms)) {
+            benchTime[mode] += ms;
+            benchCount[mode]++;
+        }
+
+        benchFrame++;
+        if (benchFrame < RENDER_MODES * BENCH_FRAMES) {
+            if (benchFrame % BENCH_FRAMES == 0) {
+                setRenderMode(benchFrame / BENCH_FRAMES);
+            }
+            return;
+        }
+
+        const char *names[RENDER_MODES] = {
+            "  depth pre-pass:    ", "  single pass:       ", "  single pass fp32:  "
+        };
+        double avg[RENDER_MODES];
+        for (int i = 0; i < RENDER_MODES; i++) {
+            std::cout << names[i];
+            avg[i] = benchCount[i] > 0 ? benchTime[i] / benchCount[i] : 0.0;
+            if (benchCount[i] > 0) {
+                std::cout << avg[i] << " ms GPU per frame (" << benchCount[i] << " frames)\n";
+            } else {
+                std::cout << "no GPU timings available\n";
+            }
+        }
+        // same geometry and passes: the difference is the fragment shading cost
+        if (!shaderFloat16) {
+            std::cout << "  fp16 shaders not supported, both single pass modes use fp32\n";
+        } else if (benchCount[SINGLE_PASS] > 0 && benchCount[SINGLE_PASS_FP32] > 0) {
+            std::cout << "  fp16 - fp32 fragment cost: " << avg[SINGLE_PASS] - avg[SINGLE_PASS_FP32] <<
+                         " ms (" << 100.0 * (avg[SINGLE_PASS] - avg[SINGLE_PASS_FP32]) / avg[SINGLE_PASS_FP32] << "%)\n";
+        }
+        benchFrame = -1;
+        setRenderMode(PREPASS);
+    }
+
     void handleDelete() {
         int dState = glfwGetKey(window, GLFW_KEY_D);
 
         if (dState == GLFW_PRESS && prevDState == GLFW_RELEASE && editMode) {
-            if (selectedListPos >= 0 && selectedListPos < (int)selectableIds.size()) {
-                const std::string id = selectableIds[selectedListPos];
-                const bool wasVisible = (hiddenIds.count(id) == 0);
+            if (selectedListPos >= 0 && selectedListPos < (int)selectable.size()) {
+                const int h = selectable[selectedListPos];
 
-                if (wasVisible) {
-                    hiddenIds.insert(id);
+                if (SC.I[h]->spawned) {
+                    SM.removeCaster(h);
+                    SC.removeInstance(h);
+                    selectable.erase(selectable.begin() + selectedListPos);
+                    selectedListPos = -1;
+                    selectedHandle = -1;
+                    txt.invalidate();
+                } else if (!SC.isHidden(h)) {
+                    Instance *inst = SC.I[h];
+                    SC.setHidden(h, true);
+                    SC.setSelected(h, false);
+                    SM.setCaster(inst->TIp - SC.TI, inst - inst->TIp->I, false);
+                    inst->occluder = false;
+                    SC.store.flags[h] &= ~INSTANCE_OCCLUDER;
                     selectedListPos = -1;
-                    selectedObjectIndex = -1;
+                    selectedHandle = -1;
                 }
 
-                const std::string curr =
-                    (selectedListPos < (int)selectableIds.size())
-                    ? "Currently editing: \n" + selectableIds[selectedListPos]
-                    : "Currently editing: \nNone";
-
-                txt.print(-0.95f, -0.85f, curr, 2, "SS", false,
+                txt.print(-0.95f, -0.85f, currentlyEditingString(), 2, "SS", false,
                     true, true, TAL_LEFT, TRH_LEFT, TRV_TOP);
 
                 // Refresh list if L is currently held
@@ -487,6 +1090,100 @@ protected:
         prevDState = dState;
     }
 
+    // The lightmap is baked for the instances of scene.json only: their copies would have no region
+    bool spawnable(const Instance &src) {
+        return (lmTI < 0) || (src.TIp != &SC.TI[lmTI]);
+    }
+
+    int spawnCopy(const Instance &src, const std::string &id, glm::vec3 offset) {
+        Instance w = src;
+        Scene::decompose(src.Wm, &w);   // world, the copy has no parent
+        int h = SC.addInstance(src.mat, src.Mid, id, w.pos + offset, w.rot, w.scl);
+        if (h >= 0) {
+            SM.addCaster(h);
+        }
+        return h;
+    }
+
+    void handleSpawn() {
+        int nState = glfwGetKey(window, GLFW_KEY_N);
+
+        if (nState == GLFW_PRESS && prevNState == GLFW_RELEASE && editMode && selectedHandle >= 0) {
+            const Instance &src = *SC.I[selectedHandle];
+            int h = -1;
+            if (spawnable(src)) {
+                h = spawnCopy(src, SC.Names[src.name] + " (copy)", glm::vec3(5.0f, 0.0f, 0.0f));
+            } else {
+                std::cout << "Lightmapped instances cannot be copied: " << SC.Names[src.name] << "\n";
+            }
+            if (h >= 0) {
+                selectable.push_back(h);
+                SC.setSelected(selectedHandle, false);
+                selectedListPos = selectable.size() - 1;
+                selectedHandle = h;
+                SC.setSelected(h, true);
+                txt.print(-0.95f, -0.85f, currentlyEditingString(), 2, "SS", false,
+                    true, true, TAL_LEFT, TRH_LEFT, TRV_TOP);
+                txt.invalidate();
+            }
+        }
+        prevNState = nState;
+
+        int mState = glfwGetKey(window, GLFW_KEY_M);
+        if (mState == GLFW_PRESS && prevMState == GLFW_RELEASE && stressFrame < 0 && !selectable.empty()) {
+            if (!spawnable(*SC.I[selectable[0]])) {
+                std::cout << "Spawn stress test: the first instance is lightmapped and cannot be copied\n";
+                prevMState = mState;
+                return;
+            }
+            std::cout << "Spawn stress test: " << STRESS_FRAMES * STRESS_BATCH << " instances, at most " <<
+                         STRESS_LIVE << " at the same time\n";
+            stressFrame = 0;
+            stressAddUs = stressRemoveUs = 0.0;
+            stressAdded = stressRemoved = 0;
+        }
+        prevMState = mState;
+
+        if (stressFrame < 0) {
+            return;
+        }
+        const Instance &src = *SC.I[selectable[0]];
+        auto t0 = std::chrono::high_resolution_clock::now();
+        for (int b = 0; (stressFrame < STRESS_FRAMES) && (b < STRESS_BATCH); b++) {
+            int n = stressFrame * STRESS_BATCH + b;
+            glm::vec3 offset((n % 64 - 32) * 1.5f, 0.0f, (n / 64 % 64 - 32) * 1.5f);
+            int h = spawnCopy(src, "stress", offset);
+            if (h >= 0) {
+                stressHandles.push_back(h);
+                stressAdded++;
+            }
+        }
+        auto t1 = std::chrono::high_resolution_clock::now();
+        int live = (stressFrame < STRESS_FRAMES) ? STRESS_LIVE : 0;
+        while ((int)stressHandles.size() > live) {
+            SM.removeCaster(stressHandles.front());
+            SC.removeInstance(stressHandles.front());
+            stressHandles.pop_front();
+            stressRemoved++;
+        }
+        auto t2 = std::chrono::high_resolution_clock::now();
+        stressAddUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+        stressRemoveUs += std::chrono::duration<double, std::micro>(t2 - t1).count();
+        stressFrame++;
+        txt.invalidate();
+
+        std::ostringstream s;
+        s.precision(2);
+        s << std::fixed << "Spawned: " << SC.spawnedCount << " - add " << stressAddUs / std::max(stressAdded, 1) <<
+             " us, remove " << stressRemoveUs / std::max(stressRemoved, 1) << " us - sets " <<
+             SC.spawnSetsAllocated << " new, " << SC.spawnSetsReused << " reused, " << SC.spawnChunkCount() << " pools";
+        if (stressFrame > STRESS_FRAMES) {
+            std::cout << s.str() << "\n";
+            stressFrame = -1;
+        }
+        txt.print(0.95f, -0.74f, s.str(), 8, "SS", false, true, true, TAL_RIGHT, TRH_RIGHT, TRV_TOP);
+    }
+
     void handleModeToggle() {
         int qState = glfwGetKey(window, GLFW_KEY_Q);
 
@@ -523,17 +1220,12 @@ protected:
         int tabState = glfwGetKey(window, GLFW_KEY_TAB);
 
         if (tabState == GLFW_PRESS && prevTabState == GLFW_RELEASE) {
-            if (selectableIndices.empty() || !selectNextVisible()) {
+            if (selectable.empty() || !selectNextVisible()) {
                 selectedListPos = -1;
-                selectedObjectIndex = -1;
+                selectedHandle = -1;
             }
 
-            const std::string curr =
-                (selectedListPos >= 0 && selectedListPos < (int)selectableIds.size())
-                ? "Currently editing: \n" + selectableIds[selectedListPos]
-                : "Currently editing: \nNone";
-
-            txt.print(-0.95f, -0.85f, curr, 2, "SS", false,
+            txt.print(-0.95f, -0.85f, currentlyEditingString(), 2, "SS", false,
                         true, true, TAL_LEFT, TRH_LEFT, TRV_TOP);
 
             txt.updateCommandBuffer();
@@ -542,17 +1234,97 @@ protected:
         prevTabState = tabState;
     }
 
-    void buildSelectableFromJSON(const char* path) {
+    // Bakes (or finds in the cache) the lightmap of the "Lightmapped" instances: their
+    // models get their lightmap charts, and the technique its texture
+    void bakeLightmap() {
+        for (int k = 0; k < SC.TechniqueInstanceCount; k++) {
+            if (SC.TI[k].T == &PRs[1]) lmTI = k;
+        }
+        if (lmTI < 0) return;
+
+        for (auto &l : LC.lights) {
+            LMB.addLight(glm::vec3(l.posRadius), glm::vec3(l.color), l.posRadius.w);
+        }
+        LMB.g = 5.0f;
+        LMB.decayFactor = 1.0f;
+        std::string file = LMB.bake(this, &SC, lmTI, offsetof(VertexLM, UV2), "assets/lightmaps");
+
+        // no mipmaps: they would mix the charts
+        TLM.init(this, file, VK_FORMAT_R8G8B8A8_UNORM, false);
+        TLM.createTextureSampler(VK_FILTER_LINEAR, VK_FILTER_LINEAR,
+                                 VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+                                 VK_SAMPLER_MIPMAP_MODE_NEAREST, VK_FALSE, 1.0f, 0.0f);
+        for (auto &pt : PRs[1].PT) {
+            pt.texDefs[2][2].info = TLM.getViewAndSampler();
+        }
+    }
+
+    // Textures of the "textures" section of the scene, before it is loaded
+    int textureCountFromJSON(const char* path) {
         std::ifstream f(path);
-        if (!f) return;
-        nlohmann::json j; f >> j;
+        nlohmann::json j;
+        if (f) f >> j;
+        return (j.contains("textures") && j["textures"].is_array()) ? (int)j["textures"].size() : 0;
+    }
 
-        auto& instBlocks = j["instances"];
-        if (!instBlocks.is_array() || instBlocks.empty()) return;
+    // Lights of the clustered path: the "lights" section of the scene, or the default ones
+    void buildLightsFromJSON(const char* path) {
+        std::ifstream f(path);
+        nlohmann::json j;
+        if (f) f >> j;
+
+        if (j.contains("lights") && j["lights"].is_array()) {
+            for (auto& l : j["lights"]) {
+                auto p = l["position"];
+                auto c = l.value("color", std::vector<float>{1.0f, 0.95f, 0.9f});
+                LC.addLight(glm::vec3(p[0], p[1], p[2]), glm::vec3(c[0], c[1], c[2]),
+                            l.value("radius", 60.0f));
+            }
+        } else {
+            for (int i = 0; i < N_POINTLIGHTS; i++) {
+                LC.addLight(glm::vec3(LightPos[i]), glm::vec3(1.0f, 0.95f, 0.9f), 60.0f);
+            }
+        }
+        std::cout << LC.lights.size() << " point lights\n";
+    }
 
-        auto& elements = instBlocks[0]["elements"];
-        if (!elements.is_array()) return;
+    // Cells (boxes and instance ids) and portals (door openings between two cells)
+    void buildCellsFromJSON(const char* path) {
+        std::ifstream f(path);
+        nlohmann::json j;
+        if (f) f >> j;
+
+        CP.init(&SC);
+        if (j.contains("cells") && j["cells"].is_array()) {
+            for (auto& c : j["cells"]) {
+                int id = CP.addCell(c["id"].get<std::string>());
+                for (auto& b : c["boxes"]) {
+                    CP.addBox(id, glm::vec3(b[0][0], b[0][1], b[0][2]), glm::vec3(b[1][0], b[1][1], b[1][2]));
+                }
+                for (auto& i : c["instances"]) {
+                    CP.addInstance(id, i.get<std::string>());
+                }
+            }
+        }
+        if (j.contains("portals") && j["portals"].is_array()) {
+            for (auto& p : j["portals"]) {
+                auto a = CP.cellIds.find(p["cells"][0].get<std::string>());
+                auto b = CP.cellIds.find(p["cells"][1].get<std::string>());
+                if (a == CP.cellIds.end() || b == CP.cellIds.end()) {
+                    std::cout << "Portal with an unknown cell\n";
+                    continue;
+                }
+                std::vector<glm::vec3> polygon;
+                for (auto& v : p["polygon"]) {
+                    polygon.push_back(glm::vec3(v[0], v[1], v[2]));
+                }
+                CP.addPortal(a->second, b->second, polygon);
+            }
+        }
+        std::cout << CP.cells.size() << " cells, " << CP.portals.size() << " portals\n";
+    }
 
+    void buildSelectable() {
         // Instances we do not edit
         auto isUnselectable = [](const std::string& id){
             std::string s = id;
@@ -560,25 +1332,32 @@ protected:
             return (s == "floor" || s == "wall" || s =="door" || s == "window");
         };
 
-        selectableIndices.clear();
-        selectableIds.clear();
+        selectable.clear();
 
-        for (int i = 0; i < (int)elements.size(); ++i) {
-            std::string id = elements[i].value("id", std::string{});
+        for (int i = 0; i < SC.TI[0].InstanceCount; ++i) {
+            const Instance &inst = SC.TI[0].I[i];
 
-            if (id.empty() || !isUnselectable(id)) {
-                selectableIndices.push_back(i);  // keep instance index
-                selectableIds.push_back(id.empty() ? ("instance_" + std::to_string(i)) : id);
+            if (!isUnselectable(SC.Names[inst.name])) {
+                selectable.push_back(inst.Iid);
             }
         }
     }
 
+    std::string currentlyEditingString() const {
+        if (selectedHandle < 0) {
+            return "Currently editing: \nNone";
+        }
+        const std::string &id = SC.Names[SC.I[selectedHandle]->name];
+        return "Currently editing: \n" + (id.empty() ? ("instance_" + std::to_string(selectedHandle)) : id);
+    }
+
     std::string makeVisibleListString() const {
         std::string s;
 
-        for (size_t i = 0; i < selectableIds.size(); ++i) {
-            if (hiddenIds.count(selectableIds[i]) == 0) {
-                s += selectableIds[i] + "\n";
+        for (int h : selectable) {
+            if (!SC.isHidden(h)) {
+                const std::string &id = SC.Names[SC.I[h]->name];
+                s += (id.empty() ? ("instance_" + std::to_string(h)) : id) + "\n";
             }
         }
 
@@ -590,25 +1369,29 @@ protected:
     }
 
     bool selectNextVisible() {
-        if (selectableIndices.empty()){
+        if (selectedHandle >= 0) {
+            SC.setSelected(selectedHandle, false);
+        }
+        if (selectable.empty()){
             selectedListPos = -1;
-            selectedObjectIndex = -1;
+            selectedHandle = -1;
             return false;
         }
 
         int step = 1;
-        const int n = (int)selectableIndices.size();
+        const int n = (int)selectable.size();
 
         for (int k = 0; k < n; ++k) {
             selectedListPos = (selectedListPos + step + n) % n; // Increases with step and wraps around if at the end
 
-            if (hiddenIds.count(selectableIds[selectedListPos]) == 0) {
-                selectedObjectIndex = selectableIndices[selectedListPos];
+            if (!SC.isHidden(selectable[selectedListPos])) {
+                selectedHandle = selectable[selectedListPos];
+                SC.setSelected(selectedHandle, true);
                 return true;
             }
         }
         selectedListPos = -1;
-        selectedObjectIndex = -1;
+        selectedHandle = -1;
         return false;
     }
 };
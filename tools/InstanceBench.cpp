@@ -0,0 +1,94 @@
+// Microbenchmark of the batch kernels of InstanceStore: model-view-projection and normal
+// matrices of 1k, 10k and 100k random instances, with the SIMD kernels, the scalar ones
+// and the per instance glm code they replace (VP * Wm, inverse(transpose(Wm))).
+//
+// Build and run from the repository root:
+//    g++ -O2 -mavx2 -std=c++17 -Iinclude tools/InstanceBench.cpp -o InstanceBench
+//    ./InstanceBench
+// (or build the InstanceBench CMake target, with -DCG_HOSPITAL_AVX2=ON for the 8 lanes)
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <functional>
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#define SCENE_IMPLEMENTATION
+#include "modules/InstanceStore.hpp"
+
+// average ns per instance of f, repeated until at least 200 ms have passed
+static double timePerInstance(int n, const std::function<void()> &f) {
+	f();
+	int reps = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	double elapsed = 0.0;
+	do {
+		f();
+		reps++;
+		elapsed = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start).count();
+	} while(elapsed < 2e8);
+	return elapsed / reps / n;
+}
+
+static float maxDifference(const std::vector<glm::mat4> &a, const std::vector<glm::mat4> &b, int rows) {
+	float d = 0.0f;
+	for(int i = 0; i < a.size(); i++) {
+		for(int c = 0; c < rows; c++) {
+			for(int r = 0; r < rows; r++) {
+				d = std::max(d, std::abs(a[i][c][r] - b[i][c][r]));
+			}
+		}
+	}
+	return d;
+}
+
+int main() {
+	std::cout << "Instance kernels, " << INSTANCE_LANES << " lanes (ns per instance)\n\n";
+	std::cout << std::setw(10) << "instances" << std::setw(10) << "glm MVP" << std::setw(10) << "scalar" <<
+				 std::setw(10) << "SIMD" << std::setw(12) << "glm normal" << std::setw(10) << "scalar" <<
+				 std::setw(10) << "SIMD" << std::setw(12) << "max error" << "\n";
+
+	glm::mat4 Prj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.01f, 270.0f);
+	glm::mat4 VP = Prj * glm::lookAt(glm::vec3(0, 40, 6), glm::vec3(0, 20, -30), glm::vec3(0, 1, 0));
+
+	for(int n : {1000, 10000, 100000}) {
+		std::mt19937 rng(n);
+		std::uniform_real_distribution<float> U(-1.0f, 1.0f);
+		InstanceStore S;
+		std::vector<glm::mat4> Wm(n);
+		for(int i = 0; i < n; i++) {
+			Wm[i] = glm::translate(glm::mat4(1.0f), glm::vec3(U(rng), U(rng), U(rng)) * 100.0f) *
+					glm::rotate(glm::mat4(1.0f), U(rng) * 3.14f, glm::normalize(glm::vec3(U(rng), U(rng), U(rng)) + 1e-3f)) *
+					glm::scale(glm::mat4(1.0f), glm::vec3(0.1f + 0.05f * U(rng)));
+			S.add(Wm[i], glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), 0, 0);
+		}
+
+		std::vector<glm::mat4> ref(n), out(n), nref(n), nout(n);
+		double tGlm = timePerInstance(n, [&]() {
+			for(int i = 0; i < n; i++) ref[i] = VP * Wm[i];
+		});
+		double tScalar = timePerInstance(n, [&]() {S.computeMVP(VP, out.data(), false);});
+		double tSimd = timePerInstance(n, [&]() {S.computeMVP(VP, out.data(), true);});
+		float err = maxDifference(ref, out, 4);
+
+		double tGlmN = timePerInstance(n, [&]() {
+			for(int i = 0; i < n; i++) nref[i] = glm::inverse(glm::transpose(Wm[i]));
+		});
+		double tScalarN = timePerInstance(n, [&]() {S.computeNormals(nout.data(), false);});
+		double tSimdN = timePerInstance(n, [&]() {S.computeNormals(nout.data(), true);});
+		// relative to the size of the normal matrix (1 / scale)
+		err = std::max(err, maxDifference(nref, nout, 3) * 0.1f);
+
+		std::cout << std::fixed << std::setprecision(2) << std::setw(10) << n <<
+					 std::setw(10) << tGlm << std::setw(10) << tScalar << std::setw(10) << tSimd <<
+					 std::setw(12) << tGlmN << std::setw(10) << tScalarN << std::setw(10) << tSimdN <<
+					 std::setprecision(6) << std::setw(12) << err << "\n";
+	}
+	return 0;
+}
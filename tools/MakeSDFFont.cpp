@@ -0,0 +1,213 @@
+// Offline generator of the signed distance field font used by TextMaker::setSDF().
+// It takes the regular (large) face of each family from the bitmap atlas
+// assets/textures/Fonts.png, computes the distance field of its fill channel and
+// packs the three families in a single small atlas.
+//
+// Build and run from the repository root:
+//    g++ -O2 -std=c++17 -Iinclude tools/MakeSDFFont.cpp -o MakeSDFFont
+//    ./MakeSDFFont assets/textures/Fonts.png assets/textures/FontsSDF.png include/modules/TextMakerSDFFont.hpp
+// (or build the MakeSDFFont CMake target)
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cmath>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#define TEXTMAKER_IMPLEMENTATION
+#include "modules/TextMakerFonts.hpp"
+
+const int familyFace[SDF_FONT_FAMILIES] = {0, 8, 16};	// regular face of mono, sans and serif
+const int SPREAD = 8;		// face pixels
+const int DOWNSAMPLE = 2;	// face pixels per atlas pixel
+const int ATLAS_W = 512;
+const float INF = 1e20f;
+
+struct Glyph {
+	int fam, c;
+	int w, h;			// size in face pixels, padding included
+	int aw, ah;			// size in atlas pixels
+	int ax = 0, ay = 0;	// position in the atlas
+	std::vector<float> dist;	// signed distance, face pixels, positive inside
+};
+
+// 1D squared euclidean distance transform (Felzenszwalb and Huttenlocher)
+void edt1d(const float *f, float *d, int n, std::vector<int> &v, std::vector<float> &z) {
+	int k = 0;
+	v[0] = 0;
+	z[0] = -INF;
+	z[1] = INF;
+	for(int q = 1; q < n; q++) {
+		float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+		while(s <= z[k]) {
+			k--;
+			s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+		}
+		k++;
+		v[k] = q;
+		z[k] = s;
+		z[k + 1] = INF;
+	}
+	k = 0;
+	for(int q = 0; q < n; q++) {
+		while(z[k + 1] < q) {
+			k++;
+		}
+		d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+	}
+}
+
+// distance of every pixel from the nearest pixel where mask == target
+std::vector<float> edt(const std::vector<bool> &mask, bool target, int w, int h) {
+	int n = std::max(w, h);
+	std::vector<float> grid(w * h), f(n), d(n), z(n + 1);
+	std::vector<int> v(n);
+	for(int i = 0; i < w * h; i++) {
+		grid[i] = (mask[i] == target) ? 0.0f : INF;
+	}
+	for(int x = 0; x < w; x++) {
+		for(int y = 0; y < h; y++) f[y] = grid[y * w + x];
+		edt1d(f.data(), d.data(), h, v, z);
+		for(int y = 0; y < h; y++) grid[y * w + x] = d[y];
+	}
+	for(int y = 0; y < h; y++) {
+		edt1d(&grid[y * w], d.data(), w, v, z);
+		for(int x = 0; x < w; x++) grid[y * w + x] = std::sqrt(d[x]);
+	}
+	return grid;
+}
+
+int main(int argc, char *argv[]) {
+	if(argc != 4) {
+		std::cout << "Usage: " << argv[0] << " <Fonts.png> <FontsSDF.png> <TextMakerSDFFont.hpp>\n";
+		return 1;
+	}
+
+	int texW, texH, texC;
+	unsigned char *src = stbi_load(argv[1], &texW, &texH, &texC, STBI_rgb_alpha);
+	if(!src) {
+		std::cout << "Cannot load " << argv[1] << "\n";
+		return 1;
+	}
+
+	// distance fields of all the glyphs, at face resolution
+	std::vector<Glyph> G;
+	int baseline[SDF_FONT_FAMILIES];
+	for(int fam = 0; fam < SDF_FONT_FAMILIES; fam++) {
+		const FontDef &F = mainFont.faces[familyFace[fam]];
+		const CharData &H = F.P['H' - mainFont.minChar];
+		baseline[fam] = H.yoffset + H.height;
+		for(int c = 0; c < FONT_CHARS; c++) {
+			const CharData &d = F.P[c];
+			Glyph g;
+			g.fam = fam;
+			g.c = c;
+			if((d.width == 0) || (d.height == 0)) {
+				g.w = g.h = g.aw = g.ah = 0;
+				G.push_back(g);
+				continue;
+			}
+			g.aw = (d.width  + 2 * SPREAD + DOWNSAMPLE - 1) / DOWNSAMPLE;
+			g.ah = (d.height + 2 * SPREAD + DOWNSAMPLE - 1) / DOWNSAMPLE;
+			g.w = g.aw * DOWNSAMPLE;
+			g.h = g.ah * DOWNSAMPLE;
+
+			// fill channel of the bitmap font (red), thresholded at half coverage
+			std::vector<bool> inside(g.w * g.h, false);
+			for(int y = 0; y < d.height; y++) {
+				for(int x = 0; x < d.width; x++) {
+					inside[(y + SPREAD) * g.w + x + SPREAD] =
+							src[((d.y + y) * texW + d.x + x) * 4] >= 128;
+				}
+			}
+			std::vector<float> dOut = edt(inside, true, g.w, g.h);
+			std::vector<float> dIn  = edt(inside, false, g.w, g.h);
+			g.dist.resize(g.w * g.h);
+			for(int i = 0; i < g.w * g.h; i++) {
+				g.dist[i] = inside[i] ? (dIn[i] - 0.5f) : -(dOut[i] - 0.5f);
+			}
+			G.push_back(g);
+		}
+	}
+	stbi_image_free(src);
+
+	// shelf packing, tallest glyphs first
+	std::vector<int> order(G.size());
+	for(int i = 0; i < (int)G.size(); i++) order[i] = i;
+	std::sort(order.begin(), order.end(), [&](int a, int b) {return G[a].ah > G[b].ah;});
+	int px = 1, py = 1, shelfH = 0;
+	for(int i : order) {
+		Glyph &g = G[i];
+		if(g.aw == 0) continue;
+		if(px + g.aw + 1 > ATLAS_W) {
+			px = 1;
+			py += shelfH + 1;
+			shelfH = 0;
+		}
+		g.ax = px;
+		g.ay = py;
+		px += g.aw + 1;
+		shelfH = std::max(shelfH, g.ah);
+	}
+	int atlasH = 1;
+	while(atlasH < py + shelfH + 1) atlasH *= 2;
+
+	// box filter down to atlas resolution, 0.5 is the edge
+	std::vector<unsigned char> atlas(ATLAS_W * atlasH, 0);
+	for(auto &g : G) {
+		for(int y = 0; y < g.ah; y++) {
+			for(int x = 0; x < g.aw; x++) {
+				float s = 0.0f;
+				for(int j = 0; j < DOWNSAMPLE; j++) {
+					for(int i = 0; i < DOWNSAMPLE; i++) {
+						s += g.dist[(y * DOWNSAMPLE + j) * g.w + x * DOWNSAMPLE + i];
+					}
+				}
+				s /= (float)(DOWNSAMPLE * DOWNSAMPLE);
+				float v = std::clamp(0.5f + s / (2.0f * SPREAD), 0.0f, 1.0f);
+				atlas[(g.ay + y) * ATLAS_W + g.ax + x] = (unsigned char)std::lround(v * 255.0f);
+			}
+		}
+	}
+	if(!stbi_write_png(argv[2], ATLAS_W, atlasH, 1, atlas.data(), ATLAS_W)) {
+		std::cout << "Cannot write " << argv[2] << "\n";
+		return 1;
+	}
+
+	std::ofstream out(argv[3]);
+	if(!out) {
+		std::cout << "Cannot write " << argv[3] << "\n";
+		return 1;
+	}
+	out << "// Generated by tools/MakeSDFFont.cpp from assets/textures/Fonts.png: do not edit\n\n";
+	out << "#ifdef TEXTMAKER_IMPLEMENTATION\n";
+	out << "extern constexpr SDFFont sdfFont = {\n";
+	out << "\t" << mainFont.minChar << ", " << mainFont.maxChar << ", " << ATLAS_W << ", " << atlasH << ",\n";
+	out << "\t\"assets/textures/FontsSDF.png\",\n";
+	out << "\t" << DOWNSAMPLE << ".0f, " << SPREAD << ".0f,\n";
+	out << "\t{" << baseline[0] << ", " << baseline[1] << ", " << baseline[2] << "},\n";
+	out << "{\n";
+	for(int fam = 0; fam < SDF_FONT_FAMILIES; fam++) {
+		const FontDef &F = mainFont.faces[familyFace[fam]];
+		out << "{" << F.lineHeight << ",{\n";
+		for(int c = 0; c < FONT_CHARS; c++) {
+			const Glyph &g = G[fam * FONT_CHARS + c];
+			const CharData &d = F.P[c];
+			out << "{" << g.ax << "," << g.ay << "," << g.aw << "," << g.ah << ","
+				<< (g.aw ? d.xoffset - SPREAD : d.xoffset) << ","
+				<< (g.aw ? d.yoffset - SPREAD : d.yoffset) << "," << d.xadvance << "}"
+				<< (c < FONT_CHARS - 1 ? ",\n" : "}}");
+		}
+		out << (fam < SDF_FONT_FAMILIES - 1 ? ",\n" : "\n");
+	}
+	out << "}\n};\n#else\nextern const SDFFont sdfFont;\n#endif\n";
+
+	std::cout << "Atlas " << ATLAS_W << "x" << atlasH << ", " << G.size() << " glyphs\n";
+	return 0;
+}